@@ -60,8 +60,33 @@ makeNonNegativeIntegerBlock(uint32_t type, uint64_t value)
 uint64_t
 readNonNegativeInteger(const Block& block)
 {
+  size_t size = block.value_size();
+  if (block.hasValue() && block.getBuffer()->isReadable(block.value(), 8) &&
+      (size == 1 || size == 2 || size == 4 || size == 8)) {
+    return tlv::detail::readNumberPadded(block.value(), size);
+  }
+
   Buffer::const_iterator begin = block.value_begin();
-  return tlv::readNonNegativeInteger(block.value_size(), begin, block.value_end());
+  return tlv::readNonNegativeInteger(size, begin, block.value_end());
+}
+
+void
+readNonNegativeIntegerBlocks(Buffer::const_iterator& begin, const Buffer::const_iterator& end,
+                             const uint32_t* types, uint64_t* values, size_t nBlocks)
+{
+  for (size_t i = 0; i < nBlocks; ++i) {
+    uint32_t type = tlv::readType(begin, end);
+    if (type != types[i])
+      BOOST_THROW_EXCEPTION(tlv::Error("Unexpected TLV-TYPE " + std::to_string(type) +
+                                       " (expecting " + std::to_string(types[i]) + ")"));
+
+    uint64_t length = tlv::readVarNumber(begin, end);
+    if (length > 8)
+      BOOST_THROW_EXCEPTION(tlv::Error("Invalid length for nonNegativeInteger "
+                                       "(only 1, 2, 4, and 8 are allowed)"));
+
+    values[i] = tlv::readNonNegativeInteger(static_cast<size_t>(length), begin, end);
+  }
 }
 
 ////////
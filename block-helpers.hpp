@@ -39,6 +39,39 @@ template<Tag TAG>
 size_t
 prependNonNegativeIntegerBlock(EncodingImpl<TAG>& encoder, uint32_t type, uint64_t value);
 
+/**
+ * @brief Helper to prepend TLV-TYPE @p TYPE and TLV-LENGTH @p length with a single write
+ * @tparam TYPE TLV-TYPE known at compile time
+ */
+template<uint32_t TYPE, Tag TAG>
+inline size_t
+prependTypeAndLength(EncodingImpl<TAG>& encoder, uint64_t length)
+{
+  uint8_t header[tlv::TypeHeader<TYPE>::SIZE + 9];
+  size_t headerLength = tlv::TypeHeader<TYPE>::write(header);
+  headerLength += tlv::writeVarNumber(header + headerLength, length);
+
+  return encoder.prependByteArray(header, headerLength);
+}
+
+/**
+ * @brief Helper to prepend TLV block type @p TYPE containing non-negative integer @p value
+ * @tparam TYPE TLV-TYPE known at compile time
+ * @see makeNonNegativeIntegerBlock, readNonNegativeInteger
+ */
+template<uint32_t TYPE, Tag TAG>
+inline size_t
+prependNonNegativeIntegerBlock(EncodingImpl<TAG>& encoder, uint64_t value)
+{
+  // TLV-LENGTH of a nonNegativeInteger is at most 8, i.e., always a single octet
+  uint8_t block[tlv::TypeHeader<TYPE>::SIZE + 1 + 8];
+  size_t headerLength = tlv::TypeHeader<TYPE>::write(block);
+  size_t valueLength = tlv::writeNonNegativeInteger(block + headerLength + 1, value);
+  block[headerLength] = static_cast<uint8_t>(valueLength);
+
+  return encoder.prependByteArray(block, headerLength + 1 + valueLength);
+}
+
 /**
  * @brief Create a TLV block type @p type containing non-negative integer @p value
  * @see prependNonNegativeIntegerBlock, readNonNegativeInteger
@@ -54,6 +87,23 @@ makeNonNegativeIntegerBlock(uint32_t type, uint64_t value);
 uint64_t
 readNonNegativeInteger(const Block& block);
 
+/**
+ * @brief Helper to read a run of non-negative integer blocks directly from wire encoding
+ * @param begin   position of the first block; advanced past the last block read
+ * @param end     end of the encoding
+ * @param types   expected TLV-TYPE of each block, in order
+ * @param values  output array receiving the value of each block
+ * @param nBlocks number of blocks to read
+ * @see Encoder::prependNonNegativeIntegerBlocks
+ * @throw tlv::Error if a block has an unexpected type or does not contain a valid
+ *                   nonNegativeInteger
+ *
+ * Unlike readNonNegativeInteger(const Block&), this does not need the parent to be parsed.
+ */
+void
+readNonNegativeIntegerBlocks(Buffer::const_iterator& begin, const Buffer::const_iterator& end,
+                             const uint32_t* types, uint64_t* values, size_t nBlocks);
+
 ////////
 
 /**
@@ -64,6 +114,22 @@ template<Tag TAG>
 size_t
 prependEmptyBlock(EncodingImpl<TAG>& encoder, uint32_t type);
 
+/**
+ * @brief Helper to prepend TLV block type @p TYPE containing no value (i.e., a boolean block)
+ * @tparam TYPE TLV-TYPE known at compile time
+ * @see makeEmptyBlock
+ */
+template<uint32_t TYPE, Tag TAG>
+inline size_t
+prependEmptyBlock(EncodingImpl<TAG>& encoder)
+{
+  uint8_t block[tlv::TypeHeader<TYPE>::SIZE + 1];
+  size_t headerLength = tlv::TypeHeader<TYPE>::write(block);
+  block[headerLength] = 0;
+
+  return encoder.prependByteArray(block, headerLength + 1);
+}
+
 /**
  * @brief Create a TLV block type @p type containing no value (i.e., a boolean block)
  * @see prependEmptyBlock
@@ -81,6 +147,20 @@ template<Tag TAG>
 size_t
 prependStringBlock(EncodingImpl<TAG>& encoder, uint32_t type, const std::string& value);
 
+/**
+ * @brief Helper to prepend TLV block type @p TYPE with value from a string @p value
+ * @tparam TYPE TLV-TYPE known at compile time
+ * @see makeStringBlock, readString
+ */
+template<uint32_t TYPE, Tag TAG>
+inline size_t
+prependStringBlock(EncodingImpl<TAG>& encoder, const std::string& value)
+{
+  size_t valueLength = encoder.prependByteArray(reinterpret_cast<const uint8_t*>(value.data()),
+                                                value.size());
+  return valueLength + prependTypeAndLength<TYPE>(encoder, valueLength);
+}
+
 /**
  * @brief Create a TLV block type @p type with value from a string @p value
  * @see prependStringBlock, readString
@@ -202,6 +282,22 @@ prependNestedBlock(EncodingImpl<TAG>& encoder, uint32_t type, const U& value)
   return totalLength;
 }
 
+/**
+ * @brief Prepend a TLV block of type @p TYPE with WireEncodable @p value as a value
+ * @tparam TYPE TLV-TYPE known at compile time
+ * @tparam U type that satisfies WireEncodableWithEncodingBuffer concept
+ * @see makeNestedBlock
+ */
+template<uint32_t TYPE, Tag TAG, class U>
+inline size_t
+prependNestedBlock(EncodingImpl<TAG>& encoder, const U& value)
+{
+  BOOST_CONCEPT_ASSERT((WireEncodableWithEncodingBuffer<U>));
+
+  size_t valueLength = value.wireEncode(encoder);
+  return valueLength + prependTypeAndLength<TYPE>(encoder, valueLength);
+}
+
 /**
  * @brief Create a TLV block of type @p type with WireEncodable @p value as a value
  * @tparam U type that satisfies WireEncodableWithEncodingBuffer concept
@@ -224,6 +320,7 @@ makeNestedBlock(uint32_t type, const U& value)
 
 using encoding::makeNonNegativeIntegerBlock;
 using encoding::readNonNegativeInteger;
+using encoding::readNonNegativeIntegerBlocks;
 using encoding::makeEmptyBlock;
 using encoding::makeStringBlock;
 using encoding::readString;
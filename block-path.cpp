@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "block-path.hpp"
+
+namespace ndn {
+
+BlockPath::BlockPath(std::initializer_list<Step> steps)
+  : m_steps(steps)
+{
+  if (m_steps.empty())
+    BOOST_THROW_EXCEPTION(std::invalid_argument("BlockPath must have at least one step"));
+}
+
+BlockView
+BlockPath::evaluate(const Block& block) const
+{
+  if (!block.hasValue())
+    return BlockView();
+
+  return evaluate(block.value(), block.value() + block.value_size());
+}
+
+BlockView
+BlockPath::evaluate(const uint8_t* begin, const uint8_t* end) const
+{
+  BlockView target;
+
+  for (const Step& step : m_steps) {
+    target = findElement(begin, end, step);
+    if (target.empty())
+      return target;
+
+    // the next step selects among the sub elements of the target
+    begin = target.value_begin();
+    end = target.value_end();
+  }
+
+  return target;
+}
+
+BlockView
+BlockPath::findElement(const uint8_t* begin, const uint8_t* end, const Step& step)
+{
+  size_t nMatches = 0;
+  while (begin != end) {
+    bool isOk = false;
+    BlockView element;
+    std::tie(isOk, element) = BlockView::fromBuffer(begin, end - begin);
+    if (!isOk)
+      return BlockView();
+
+    if (element.type() == step.type && nMatches++ == step.index)
+      return element;
+
+    begin = element.value_end();
+  }
+
+  return BlockView();
+}
+
+} // namespace ndn
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BLOCK_PATH_HPP
+#define NDN_ENCODING_BLOCK_PATH_HPP
+
+#include "block.hpp"
+#include "block-view.hpp"
+
+#include <initializer_list>
+
+namespace ndn {
+
+/** @brief Path to a nested element, evaluated directly on wire encoding
+ *
+ *  A path is a sequence of steps, each selecting a sub element by TLV-TYPE and, optionally,
+ *  by its position among the sub elements of that type.  For example, the FreshnessPeriod of
+ *  a Data packet and the third name component of an Interest are selected by
+ *  @code
+ *  static const BlockPath freshnessPeriod{tlv::MetaInfo, tlv::FreshnessPeriod};
+ *  static const BlockPath thirdComponent{tlv::Name, {tlv::NameComponent, 2}};
+ *  @endcode
+ *
+ *  A path is built once and can then be evaluated on any number of elements.  Evaluation
+ *  reads only the headers preceding each selected element, and stops as soon as the target
+ *  is found; no Block is parsed or created.
+ */
+class BlockPath
+{
+public:
+  /** @brief Step of a BlockPath
+   */
+  struct Step
+  {
+    Step(uint32_t type, size_t index = 0)
+      : type(type)
+      , index(index)
+    {
+    }
+
+    uint32_t type;
+    size_t index; ///< zero-based position among sub elements of the same type
+  };
+
+  /** @brief Create a path from @p steps
+   *  @throw std::invalid_argument @p steps is empty
+   */
+  BlockPath(std::initializer_list<Step> steps);
+
+  /** @brief Find the element selected by the path
+   *  @param block the element from whose sub elements the first step selects
+   *
+   *  This method never throws.
+   *
+   *  @return view of the target element, which refers to the wire encoding of @p block;
+   *          an empty BlockView if the target does not exist or a traversed element
+   *          is malformed
+   */
+  BlockView
+  evaluate(const Block& block) const;
+
+  /** @brief Find the element selected by the path
+   *  @param begin begin of the elements from which the first step selects
+   *  @param end end of the elements from which the first step selects
+   *
+   *  This method never throws.
+   *
+   *  @return view of the target element; an empty BlockView if the target does not exist
+   *          or a traversed element is malformed
+   */
+  BlockView
+  evaluate(const uint8_t* begin, const uint8_t* end) const;
+
+  /** @brief Find the element selected by one step among the elements in [@p begin, @p end)
+   *
+   *  Headers are decoded with BlockView::fromBuffer up to the selected element.
+   *  This method never throws.
+   *
+   *  @return view of the element; an empty BlockView if it does not exist or a preceding
+   *          element is malformed
+   */
+  static BlockView
+  findElement(const uint8_t* begin, const uint8_t* end, const Step& step);
+
+  size_t
+  size() const
+  {
+    return m_steps.size();
+  }
+
+  const Step&
+  operator[](size_t step) const
+  {
+    return m_steps[step];
+  }
+
+private:
+  std::vector<Step> m_steps;
+};
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BLOCK_PATH_HPP
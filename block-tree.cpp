@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "block-tree.hpp"
+
+namespace ndn {
+
+const size_t BlockTree::DEFAULT_MAX_DEPTH;
+
+BlockTree::BlockTree(const Block& root, size_t maxDepth, const NestedPredicate& isNested)
+  : m_buffer(root.getBuffer())
+  , m_wire(root.wire())
+  , m_maxDepth(maxDepth)
+  , m_isNested(isNested)
+{
+  if (m_isNested == nullptr)
+    BOOST_THROW_EXCEPTION(std::invalid_argument("BlockTree requires a nested type predicate"));
+
+  uint32_t valueOffset = static_cast<uint32_t>(root.value() - m_wire);
+  uint32_t valueSize = static_cast<uint32_t>(root.value_size());
+
+  // the first pass validates and counts, so that the nodes are allocated once
+  m_nodes.reserve(countNodes(root.value(), valueSize, root.type(), 0));
+  m_nodes.push_back(Node{root.type(), 0, valueOffset, valueSize, 0, 0});
+  appendChildren(0, 0);
+}
+
+bool
+BlockTree::isNestedPacketType(uint32_t type)
+{
+  switch (type) {
+  case tlv::Interest:
+  case tlv::Data:
+  case tlv::Name:
+  case tlv::Selectors:
+  case tlv::PublisherPublicKeyLocator:
+  case tlv::Exclude:
+  case tlv::MetaInfo:
+  case tlv::SignatureInfo:
+  case tlv::FinalBlockId:
+  case tlv::KeyLocator:
+  case tlv::LinkDelegation:
+  case tlv::ValidityPeriod:
+  case tlv::AdditionalDescription:
+  case tlv::DescriptionEntry:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool
+BlockTree::scanChildren(const uint8_t* value, size_t valueSize, uint32_t type, size_t depth,
+                        ChildHeaders& headers) const
+{
+  if (depth >= m_maxDepth || valueSize == 0 || !m_isNested(type))
+    return false;
+
+  if (!tlv::scanElements(value, value + valueSize, headers))
+    BOOST_THROW_EXCEPTION(tlv::Error("Malformed value of TLV-TYPE " + std::to_string(type)));
+  return true;
+}
+
+size_t
+BlockTree::countNodes(const uint8_t* value, size_t valueSize, uint32_t type, size_t depth) const
+{
+  ChildHeaders headers;
+  if (!scanChildren(value, valueSize, type, depth, headers))
+    return 1;
+
+  size_t nNodes = 1;
+  for (const tlv::ElementHeader& header : headers) {
+    nNodes += countNodes(value + header.valueOffset, header.length, header.type, depth + 1);
+  }
+  return nNodes;
+}
+
+void
+BlockTree::appendChildren(size_t nodeIndex, size_t depth)
+{
+  Node node = m_nodes[nodeIndex];
+  ChildHeaders headers;
+  if (!scanChildren(m_wire + node.valueOffset, node.valueSize, node.type, depth, headers))
+    return;
+
+  uint32_t firstChild = static_cast<uint32_t>(m_nodes.size());
+  for (const tlv::ElementHeader& header : headers) {
+    m_nodes.push_back(Node{header.type,
+                           node.valueOffset + header.offset,
+                           node.valueOffset + header.valueOffset,
+                           header.length,
+                           0, 0});
+  }
+  m_nodes[nodeIndex].firstChild = firstChild;
+  m_nodes[nodeIndex].nChildren = static_cast<uint32_t>(headers.size());
+
+  for (size_t i = 0; i < headers.size(); ++i) {
+    appendChildren(firstChild + i, depth + 1);
+  }
+}
+
+const BlockTree::Node*
+BlockTree::find(const Node& node, uint32_t type) const
+{
+  const Node* end = elements_end(node);
+  const Node* it = std::find_if(elements_begin(node), end,
+                                [type] (const Node& child) { return child.type == type; });
+  return it == end ? nullptr : it;
+}
+
+BlockView
+BlockTree::view(const Node& node) const
+{
+  return BlockView(node.type,
+                   m_wire + node.offset,
+                   m_wire + node.valueOffset,
+                   m_wire + node.valueOffset + node.valueSize);
+}
+
+Block
+BlockTree::toBlock(const Node& node) const
+{
+  Buffer::const_iterator base = m_buffer->begin() + (m_wire - m_buffer->data());
+  Buffer::const_iterator valueBegin = base + node.valueOffset;
+  Buffer::const_iterator valueEnd = valueBegin + node.valueSize;
+  return Block(m_buffer, node.type,
+               base + node.offset, valueEnd,
+               valueBegin, valueEnd);
+}
+
+} // namespace ndn
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BLOCK_TREE_HPP
+#define NDN_ENCODING_BLOCK_TREE_HPP
+
+#include "block.hpp"
+#include "block-view.hpp"
+
+#include <boost/container/small_vector.hpp>
+
+namespace ndn {
+
+/** @brief Recursively parsed tree of a wire element of NDN-TLV packet format
+ *
+ *  The whole tree is decoded at once into a single array of nodes, in which the children
+ *  of every node are contiguous.  A validating pass counts the nodes first, so the array
+ *  is allocated once with the exact size, and all nodes are released together with the tree.
+ *
+ *  The tree shares the buffer of the root Block; nodes refer to it by offset.
+ */
+class BlockTree
+{
+public:
+  /** @brief Node of a BlockTree
+   */
+  struct Node
+  {
+    uint32_t type;
+    uint32_t offset;      ///< offset of the element from the start of the root
+    uint32_t valueOffset; ///< offset of the value from the start of the root
+    uint32_t valueSize;
+    uint32_t firstChild;  ///< index of the first child in the tree
+    uint32_t nChildren;
+  };
+
+  /** @brief Predicate deciding whether the value of an element of @p type is nested TLV
+   */
+  typedef function<bool(uint32_t type)> NestedPredicate;
+
+  /** @brief Decide whether the value of an element of @p type is nested TLV, for the types
+   *         of the NDN packet format, such as Name, MetaInfo, or KeyLocator
+   *
+   *  Elements of other types, including binary values such as Nonce, Content, and name
+   *  components, are leaves even if their value could be decoded as TLV.  A predicate for
+   *  application types can fall back to this one.
+   */
+  static bool
+  isNestedPacketType(uint32_t type);
+
+  /** @brief Default maximum depth of a BlockTree
+   */
+  static const size_t DEFAULT_MAX_DEPTH = 16;
+
+  /** @brief Parse @p root and its descendants
+   *  @param root element with wire encoding
+   *  @param maxDepth elements at this depth below @p root are not expanded
+   *  @param isNested elements for which it returns true must contain a sequence of TLV
+   *                  elements, and all other elements are leaves
+   *  @throw tlv::Error an element selected by @p isNested is malformed
+   *  @throw Block::Error @p root does not have wire encoding
+   *  @throw std::invalid_argument @p isNested is empty
+   */
+  explicit
+  BlockTree(const Block& root, size_t maxDepth = DEFAULT_MAX_DEPTH,
+            const NestedPredicate& isNested = &isNestedPacketType);
+
+  /** @brief Get the number of nodes, including the root
+   */
+  size_t
+  size() const;
+
+  const Node&
+  root() const;
+
+  const Node*
+  elements_begin(const Node& node) const;
+
+  const Node*
+  elements_end(const Node& node) const;
+
+  /** @brief Find the first child of @p node of the requested type
+   *  @return the child, or nullptr if it does not exist
+   */
+  const Node*
+  find(const Node& node, uint32_t type) const;
+
+  /** @brief Get a non-owning view of @p node
+   */
+  BlockView
+  view(const Node& node) const;
+
+  /** @brief Create a Block of @p node sharing the buffer of the root
+   */
+  Block
+  toBlock(const Node& node) const;
+
+private:
+  /** @brief Headers of the children of one element, usually without a heap allocation
+   */
+  typedef boost::container::small_vector<tlv::ElementHeader, 32> ChildHeaders;
+
+  /** @brief Scan the children of an element, if it is to be expanded
+   *  @return whether the element is expanded
+   *  @throw tlv::Error the element is selected by m_isNested but malformed
+   */
+  bool
+  scanChildren(const uint8_t* value, size_t valueSize, uint32_t type, size_t depth,
+               ChildHeaders& headers) const;
+
+  size_t
+  countNodes(const uint8_t* value, size_t valueSize, uint32_t type, size_t depth) const;
+
+  void
+  appendChildren(size_t nodeIndex, size_t depth);
+
+private:
+  ConstBufferPtr m_buffer;
+  const uint8_t* m_wire;
+  size_t m_maxDepth;
+  NestedPredicate m_isNested;
+  std::vector<Node> m_nodes;
+};
+
+inline size_t
+BlockTree::size() const
+{
+  return m_nodes.size();
+}
+
+inline const BlockTree::Node&
+BlockTree::root() const
+{
+  return m_nodes.front();
+}
+
+inline const BlockTree::Node*
+BlockTree::elements_begin(const Node& node) const
+{
+  return m_nodes.data() + node.firstChild;
+}
+
+inline const BlockTree::Node*
+BlockTree::elements_end(const Node& node) const
+{
+  return m_nodes.data() + node.firstChild + node.nChildren;
+}
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BLOCK_TREE_HPP
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "block-view.hpp"
+
+namespace ndn {
+
+BlockView::BlockView()
+  : m_begin(nullptr)
+  , m_value_begin(nullptr)
+  , m_end(nullptr)
+  , m_type(std::numeric_limits<uint32_t>::max())
+{
+}
+
+BlockView::BlockView(const Block& block)
+  : m_begin(block.wire())
+  , m_value_begin(block.value())
+  , m_end(m_begin + block.size())
+  , m_type(block.type())
+{
+}
+
+BlockView::BlockView(const uint8_t* buffer, size_t maxSize)
+{
+  const uint8_t* tempBegin = buffer;
+  const uint8_t* tempEnd = buffer + maxSize;
+
+  m_type = tlv::readType(tempBegin, tempEnd);
+  uint64_t length = tlv::readVarNumber(tempBegin, tempEnd);
+
+  if (length > static_cast<uint64_t>(tempEnd - tempBegin))
+    {
+      BOOST_THROW_EXCEPTION(tlv::Error("Not enough data in the buffer to fully parse TLV"));
+    }
+
+  m_begin = buffer;
+  m_value_begin = tempBegin;
+  m_end = tempBegin + length;
+}
+
+BlockView::BlockView(uint32_t type,
+                     const uint8_t* begin, const uint8_t* valueBegin, const uint8_t* end)
+  : m_begin(begin)
+  , m_value_begin(valueBegin)
+  , m_end(end)
+  , m_type(type)
+{
+}
+
+std::tuple<bool, BlockView>
+BlockView::fromBuffer(const uint8_t* buffer, size_t maxSize)
+{
+  const uint8_t* tempBegin = buffer;
+  const uint8_t* tempEnd = buffer + maxSize;
+
+  uint32_t type = 0;
+  bool isOk = tlv::readType(tempBegin, tempEnd, type);
+  if (!isOk)
+    return std::make_tuple(false, BlockView());
+
+  uint64_t length;
+  isOk = tlv::readVarNumber(tempBegin, tempEnd, length);
+  if (!isOk)
+    return std::make_tuple(false, BlockView());
+
+  if (length > static_cast<uint64_t>(tempEnd - tempBegin))
+    return std::make_tuple(false, BlockView());
+
+  return std::make_tuple(true, BlockView(type, buffer, tempBegin, tempBegin + length));
+}
+
+Block
+BlockView::toBlock(const Block& owner) const
+{
+  ConstBufferPtr buffer = owner.getBuffer();
+  if (buffer == nullptr || empty() ||
+      !(buffer->buf() <= m_begin && m_end <= buffer->buf() + buffer->size()))
+    BOOST_THROW_EXCEPTION(Block::Error("BlockView does not point to the underlying buffer "
+                                       "of the block"));
+
+  Buffer::const_iterator begin = buffer->begin() + (m_begin - buffer->buf());
+  return Block(buffer, m_type,
+               begin, begin + size(),
+               begin + (m_value_begin - m_begin), begin + size());
+}
+
+Block
+BlockView::toBlock() const
+{
+  if (empty())
+    BOOST_THROW_EXCEPTION(Block::Error("BlockView is empty"));
+
+  return Block(m_begin, size());
+}
+
+BlockView::element_const_iterator
+BlockView::find(uint32_t type) const
+{
+  return std::find_if(elements_begin(), elements_end(),
+                      [type] (const BlockView& subBlock) { return subBlock.type() == type; });
+}
+
+BlockView
+BlockView::get(uint32_t type) const
+{
+  element_const_iterator it = this->find(type);
+  if (it != elements_end())
+    return *it;
+
+  BOOST_THROW_EXCEPTION(Block::Error("(BlockView::get) Requested a non-existed type [" +
+                                     std::to_string(type) + "] from BlockView"));
+}
+
+////////
+
+BlockView::element_const_iterator::element_const_iterator()
+  : m_position(nullptr)
+  , m_end(nullptr)
+{
+}
+
+BlockView::element_const_iterator::element_const_iterator(const uint8_t* position,
+                                                          const uint8_t* end)
+  : m_position(position)
+  , m_end(end)
+{
+  decode();
+}
+
+BlockView::element_const_iterator&
+BlockView::element_const_iterator::operator++()
+{
+  m_position = m_element.m_end;
+  decode();
+  return *this;
+}
+
+BlockView::element_const_iterator
+BlockView::element_const_iterator::operator++(int)
+{
+  element_const_iterator copy = *this;
+  ++*this;
+  return copy;
+}
+
+void
+BlockView::element_const_iterator::decode()
+{
+  if (m_position == m_end)
+    m_element = BlockView();
+  else
+    m_element = BlockView(m_position, m_end - m_position);
+}
+
+} // namespace ndn
@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BLOCK_VIEW_HPP
+#define NDN_ENCODING_BLOCK_VIEW_HPP
+
+#include "block.hpp"
+
+namespace ndn {
+
+/** @brief Non-owning view of a wire element of NDN-TLV packet format
+ *
+ *  A BlockView refers to wire encoding owned by a Block or Buffer, which must outlive the view.
+ *  It supports the read side of the Block API without holding a shared_ptr, so creating,
+ *  copying and iterating views never touches a reference count.
+ *
+ *  Subelements are decoded on the fly while iterating, and are not stored.
+ */
+class BlockView
+{
+public:
+  class element_const_iterator;
+
+public: // constructor, creation
+  /** @brief Create an empty BlockView
+   */
+  BlockView();
+
+  /** @brief Create a view of a Block's wire encoding
+   *  @throw Block::Error @p block does not have wire encoding
+   */
+  explicit
+  BlockView(const Block& block);
+
+  /** @brief Create a view from the raw buffer with Type-Length parsing
+   *  @param buffer wire encoding of the element
+   *  @param maxSize the maximum size of the element
+   *  @throw tlv::Error if the buffer does not start with a complete TLV element
+   */
+  BlockView(const uint8_t* buffer, size_t maxSize);
+
+  /** @brief Create a view from the wire buffer (no parsing)
+   */
+  BlockView(uint32_t type, const uint8_t* begin, const uint8_t* valueBegin, const uint8_t* end);
+
+  /** @brief Try to create a view from the raw buffer
+   *
+   *  This is the non-throwing equivalent of BlockView(const uint8_t*, size_t).
+   *
+   *  @return true and the BlockView, if BlockView is successfully created; otherwise false
+   */
+  static std::tuple<bool, BlockView>
+  fromBuffer(const uint8_t* buffer, size_t maxSize);
+
+public: // conversion
+  /** @brief Create an owning Block sharing the buffer of @p owner
+   *  @throw Block::Error the view does not refer to the wire encoding of @p owner
+   */
+  Block
+  toBlock(const Block& owner) const;
+
+  /** @brief Create an owning Block holding a copy of the viewed octets
+   */
+  Block
+  toBlock() const;
+
+public: // wire format
+  bool
+  empty() const;
+
+  const uint8_t*
+  wire() const;
+
+  size_t
+  size() const;
+
+public: // type and value
+  uint32_t
+  type() const;
+
+  const uint8_t*
+  value_begin() const;
+
+  const uint8_t*
+  value_end() const;
+
+  const uint8_t*
+  value() const;
+
+  size_t
+  value_size() const;
+
+public: // sub elements
+  element_const_iterator
+  elements_begin() const;
+
+  element_const_iterator
+  elements_end() const;
+
+  /** @brief Find the first subelement of the requested type
+   *  @return iterator to the subelement, or elements_end() if it does not exist
+   *  @throw tlv::Error a subelement preceding the requested one is malformed
+   */
+  element_const_iterator
+  find(uint32_t type) const;
+
+  /** @brief Get the first subelement of the requested type
+   *  @throw Block::Error no subelement of the requested type exists
+   */
+  BlockView
+  get(uint32_t type) const;
+
+private:
+  const uint8_t* m_begin;
+  const uint8_t* m_value_begin;
+  const uint8_t* m_end;
+  uint32_t m_type;
+};
+
+/** @brief Forward iterator over subelements of a BlockView
+ *
+ *  Incrementing the iterator decodes the header of the next subelement.
+ *  @throw tlv::Error when the next subelement is malformed
+ */
+class BlockView::element_const_iterator
+{
+public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef BlockView                 value_type;
+  typedef std::ptrdiff_t            difference_type;
+  typedef const BlockView*          pointer;
+  typedef const BlockView&          reference;
+
+  element_const_iterator();
+
+  element_const_iterator(const uint8_t* position, const uint8_t* end);
+
+  reference
+  operator*() const
+  {
+    return m_element;
+  }
+
+  pointer
+  operator->() const
+  {
+    return &m_element;
+  }
+
+  element_const_iterator&
+  operator++();
+
+  element_const_iterator
+  operator++(int);
+
+  bool
+  operator==(const element_const_iterator& other) const
+  {
+    return m_position == other.m_position;
+  }
+
+  bool
+  operator!=(const element_const_iterator& other) const
+  {
+    return m_position != other.m_position;
+  }
+
+private:
+  void
+  decode();
+
+private:
+  const uint8_t* m_position;
+  const uint8_t* m_end;
+  BlockView m_element;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+inline bool
+BlockView::empty() const
+{
+  return m_type == std::numeric_limits<uint32_t>::max();
+}
+
+inline const uint8_t*
+BlockView::wire() const
+{
+  return m_begin;
+}
+
+inline size_t
+BlockView::size() const
+{
+  return m_end - m_begin;
+}
+
+inline uint32_t
+BlockView::type() const
+{
+  return m_type;
+}
+
+inline const uint8_t*
+BlockView::value_begin() const
+{
+  return m_value_begin;
+}
+
+inline const uint8_t*
+BlockView::value_end() const
+{
+  return m_end;
+}
+
+inline const uint8_t*
+BlockView::value() const
+{
+  return m_value_begin;
+}
+
+inline size_t
+BlockView::value_size() const
+{
+  return m_end - m_value_begin;
+}
+
+inline BlockView::element_const_iterator
+BlockView::elements_begin() const
+{
+  return element_const_iterator(m_value_begin, m_end);
+}
+
+inline BlockView::element_const_iterator
+BlockView::elements_end() const
+{
+  return element_const_iterator(m_end, m_end);
+}
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BLOCK_VIEW_HPP
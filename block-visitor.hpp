@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BLOCK_VISITOR_HPP
+#define NDN_ENCODING_BLOCK_VISITOR_HPP
+
+#include "../common.hpp"
+#include "block.hpp"
+
+namespace ndn {
+namespace tlv {
+
+/** @brief Decision of a visitor upon entering an element
+ */
+enum class VisitAction {
+  DESCEND, ///< visit the sub elements of the element, which must be well-formed
+  SKIP,    ///< do not visit the sub elements of the element
+  STOP     ///< stop visiting immediately
+};
+
+/** @brief Default maximum depth of visitElements
+ */
+const size_t DEFAULT_MAX_VISIT_DEPTH = 16;
+
+namespace detail {
+
+enum class VisitStatus {
+  CONTINUE,
+  STOPPED,
+  MALFORMED
+};
+
+template<class Visitor>
+inline VisitStatus
+visitSequence(const uint8_t* begin, const uint8_t* end, Visitor& visitor,
+              size_t depth, size_t maxDepth)
+{
+  while (begin != end) {
+    uint32_t type = 0;
+    uint64_t length = 0;
+    if (!readType(begin, end, type) ||
+        !readVarNumber(begin, end, length) ||
+        length > static_cast<uint64_t>(end - begin))
+      return VisitStatus::MALFORMED;
+
+    const uint8_t* valueEnd = begin + length;
+    VisitAction action = visitor.enter(type, begin, valueEnd, depth);
+    if (action == VisitAction::STOP)
+      return VisitStatus::STOPPED;
+
+    if (action == VisitAction::DESCEND && depth < maxDepth) {
+      VisitStatus status = visitSequence(begin, valueEnd, visitor, depth + 1, maxDepth);
+      if (status != VisitStatus::CONTINUE)
+        return status;
+    }
+
+    visitor.leave(type, begin, valueEnd, depth);
+    begin = valueEnd;
+  }
+
+  return VisitStatus::CONTINUE;
+}
+
+} // namespace detail
+
+/** @brief Walk the TLV elements in [@p begin, @p end) depth-first
+ *
+ *  @param visitor provides
+ *         `VisitAction enter(uint32_t type, const uint8_t* valueBegin, const uint8_t* valueEnd,
+ *                            size_t depth)` and
+ *         `void leave(uint32_t type, const uint8_t* valueBegin, const uint8_t* valueEnd,
+ *                     size_t depth)`,
+ *         called for every element; leave() is called after the sub elements are visited,
+ *         unless the walk has been stopped
+ *  @param maxDepth elements at this depth are not descended into, even if enter() asks to;
+ *                  elements in [@p begin, @p end) are at depth 0
+ *
+ *  Nothing is allocated and nothing is copied: the visitor receives ranges of the input.
+ *  This method does not throw upon decoding error.
+ *
+ *  @return false if an element that is visited or descended into is malformed; the visitor
+ *          has seen the elements preceding it
+ */
+template<class Visitor>
+inline bool
+visitElements(const uint8_t* begin, const uint8_t* end, Visitor&& visitor,
+              size_t maxDepth = DEFAULT_MAX_VISIT_DEPTH)
+{
+  return detail::visitSequence(begin, end, visitor, 0, maxDepth) !=
+         detail::VisitStatus::MALFORMED;
+}
+
+/** @brief Walk @p block and its sub elements depth-first, directly on its wire encoding
+ *
+ *  @p block itself is visited at depth 0.
+ *
+ *  @throw Block::Error @p block does not have wire encoding
+ *  @sa visitElements(const uint8_t*, const uint8_t*, Visitor&&, size_t)
+ */
+template<class Visitor>
+inline bool
+visitElements(const Block& block, Visitor&& visitor, size_t maxDepth = DEFAULT_MAX_VISIT_DEPTH)
+{
+  return visitElements(block.wire(), block.wire() + block.size(),
+                       std::forward<Visitor>(visitor), maxDepth);
+}
+
+} // namespace tlv
+} // namespace ndn
+
+#endif // NDN_ENCODING_BLOCK_VISITOR_HPP
@@ -23,13 +23,15 @@
 
 #include "block.hpp"
 #include "block-helpers.hpp"
+#include "block-path.hpp"
 
 #include "tlv.hpp"
 #include "encoding-buffer.hpp"
-#include "buffer-stream.hpp"
 
-#include <boost/lexical_cast.hpp>
 #include <boost/asio/buffer.hpp>
+#include <boost/container/small_vector.hpp>
+
+#include <cstring>
 
 namespace ndn {
 
@@ -45,103 +47,196 @@ static_assert(std::is_nothrow_move_assignable<Block>::value,
 
 const size_t MAX_SIZE_OF_BLOCK_FROM_STREAM = MAX_NDN_PACKET_SIZE;
 
+const size_t Block::ELEMENTS_CAPACITY;
+const size_t Block::TYPE_INDEX_MIN_ELEMENTS;
+
+/** @brief Number of headers tryParse() can scan without a heap allocation
+ *
+ *  This also covers Names with many components; the recorded index is then allocated once,
+ *  with the exact size.
+ */
+static const size_t SCAN_INLINE_HEADERS = 32;
+
+/** @brief Narrow an offset or size within the buffer of a Block to 32 bits
+ *  @throw Block::Error @p offset does not fit, i.e., the Block does not lie within the first
+ *         4 GiB of its buffer
+ */
+static uint32_t
+toOffset(size_t offset)
+{
+  if (offset > std::numeric_limits<uint32_t>::max())
+    BOOST_THROW_EXCEPTION(Block::Error("Block extends beyond 4 GiB of its buffer (offset " +
+                                       std::to_string(offset) + ")"));
+  return static_cast<uint32_t>(offset);
+}
+
 Block::Block()
-  : m_type(std::numeric_limits<uint32_t>::max())
 {
 }
 
+Block::Block(const Block& other)
+  : m_base(other.m_base)
+  , m_type(other.m_type)
+  , m_size(other.m_size)
+  , m_begin(other.m_begin)
+  , m_end(other.m_end)
+  , m_value_begin(other.m_value_begin)
+  , m_value_end(other.m_value_end)
+  , m_buffer(other.m_buffer)
+  , m_elements{copyElements(other.m_elements.load(std::memory_order_acquire))}
+{
+}
+
+Block::Block(Block&& other) noexcept
+  : m_base(other.m_base)
+  , m_type(other.m_type)
+  , m_size(other.m_size)
+  , m_begin(other.m_begin)
+  , m_end(other.m_end)
+  , m_value_begin(other.m_value_begin)
+  , m_value_end(other.m_value_end)
+  , m_buffer(std::move(other.m_buffer))
+  , m_elements{other.m_elements.exchange(nullptr, std::memory_order_relaxed)}
+{
+}
+
+Block::~Block()
+{
+  delete m_elements.load(std::memory_order_relaxed);
+}
+
+Block&
+Block::operator=(const Block& other)
+{
+  if (this != &other) {
+    Block copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+Block&
+Block::operator=(Block&& other) noexcept
+{
+  if (this != &other) {
+    m_base = other.m_base;
+    m_type = other.m_type;
+    m_size = other.m_size;
+    m_begin = other.m_begin;
+    m_end = other.m_end;
+    m_value_begin = other.m_value_begin;
+    m_value_end = other.m_value_end;
+    m_buffer = std::move(other.m_buffer);
+    delete m_elements.exchange(other.m_elements.exchange(nullptr, std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+  }
+  return *this;
+}
+
+Block::Elements*
+Block::copyElements(const Elements* elements)
+{
+  if (elements == nullptr)
+    return nullptr;
+
+  unique_ptr<Elements> copy(new Elements);
+  if (!elements->index.empty())
+    copy->index = elements->index;
+  else
+    copy->blocks = elements->blocks;
+
+  copy->typeIndex = elements->typeIndex;
+  copy->smallTypes = elements->smallTypes;
+  copy->hasTypeIndex = elements->hasTypeIndex;
+  copy->valueSize = elements->valueSize;
+  copy->hasMutableIterators = elements->hasMutableIterators;
+  return copy.release();
+}
+
 Block::Block(const EncodingBuffer& buffer)
   : m_buffer(const_cast<EncodingBuffer&>(buffer).getBuffer())
-  , m_begin(buffer.begin())
-  , m_end(buffer.end())
-  , m_size(m_end - m_begin)
 {
-  m_value_begin = m_begin;
-  m_value_end   = m_end;
+  Buffer::const_iterator valueBegin = buffer.begin();
+  Buffer::const_iterator valueEnd = buffer.end();
 
-  m_type = tlv::readType(m_value_begin, m_value_end);
-  uint64_t length = tlv::readVarNumber(m_value_begin, m_value_end);
-  if (length != static_cast<uint64_t>(m_value_end - m_value_begin))
+  m_type = tlv::readType(valueBegin, valueEnd);
+  uint64_t length = tlv::readVarNumber(valueBegin, valueEnd);
+  if (length != static_cast<uint64_t>(valueEnd - valueBegin))
     {
       BOOST_THROW_EXCEPTION(tlv::Error("TLV length doesn't match buffer length"));
     }
+
+  setRange(buffer.begin(), buffer.end(), valueBegin, valueEnd);
 }
 
 Block::Block(const ConstBufferPtr& wire,
              uint32_t type,
              const Buffer::const_iterator& begin, const Buffer::const_iterator& end,
              const Buffer::const_iterator& valueBegin, const Buffer::const_iterator& valueEnd)
-  : m_buffer(wire)
-  , m_type(type)
-  , m_begin(begin)
-  , m_end(end)
-  , m_size(m_end - m_begin)
-  , m_value_begin(valueBegin)
-  , m_value_end(valueEnd)
+  : m_type(type)
+  , m_buffer(wire)
 {
+  setRange(begin, end, valueBegin, valueEnd);
 }
 
 Block::Block(const ConstBufferPtr& buffer)
   : m_buffer(buffer)
-  , m_begin(m_buffer->begin())
-  , m_end(m_buffer->end())
-  , m_size(m_end - m_begin)
 {
-  m_value_begin = m_begin;
-  m_value_end   = m_end;
+  Buffer::const_iterator valueBegin = m_buffer->begin();
+  Buffer::const_iterator valueEnd = m_buffer->end();
 
-  m_type = tlv::readType(m_value_begin, m_value_end);
+  m_type = tlv::readType(valueBegin, valueEnd);
 
-  uint64_t length = tlv::readVarNumber(m_value_begin, m_value_end);
-  if (length != static_cast<uint64_t>(m_value_end - m_value_begin))
+  uint64_t length = tlv::readVarNumber(valueBegin, valueEnd);
+  if (length != static_cast<uint64_t>(valueEnd - valueBegin))
     {
       BOOST_THROW_EXCEPTION(tlv::Error("TLV length doesn't match buffer length"));
     }
+
+  setRange(m_buffer->begin(), m_buffer->end(), valueBegin, valueEnd);
 }
 
 Block::Block(const ConstBufferPtr& buffer,
              const Buffer::const_iterator& begin, const Buffer::const_iterator& end,
              bool verifyLength/* = true*/)
   : m_buffer(buffer)
-  , m_begin(begin)
-  , m_end(end)
-  , m_size(m_end - m_begin)
 {
-  m_value_begin = m_begin;
-  m_value_end   = m_end;
+  Buffer::const_iterator valueBegin = begin;
+  Buffer::const_iterator valueEnd = end;
 
-  m_type = tlv::readType(m_value_begin, m_value_end);
-  uint64_t length = tlv::readVarNumber(m_value_begin, m_value_end);
+  m_type = tlv::readType(valueBegin, valueEnd);
+  uint64_t length = tlv::readVarNumber(valueBegin, valueEnd);
   if (verifyLength) {
-    if (length != static_cast<uint64_t>(std::distance(m_value_begin, m_value_end))) {
+    if (length != static_cast<uint64_t>(std::distance(valueBegin, valueEnd))) {
       BOOST_THROW_EXCEPTION(tlv::Error("TLV length doesn't match buffer length"));
     }
   }
+
+  setRange(begin, end, valueBegin, valueEnd);
 }
 
 Block::Block(const Block& block,
              const Buffer::const_iterator& begin, const Buffer::const_iterator& end,
              bool verifyLength/* = true*/)
   : m_buffer(block.m_buffer)
-  , m_begin(begin)
-  , m_end(end)
-  , m_size(m_end - m_begin)
 {
   if (!(m_buffer->begin() <= begin && begin <= m_buffer->end()) ||
       !(m_buffer->begin() <= end   && end   <= m_buffer->end())) {
     BOOST_THROW_EXCEPTION(Error("begin/end iterators do not point to the underlying buffer of the block"));
   }
 
-  m_value_begin = m_begin;
-  m_value_end   = m_end;
+  Buffer::const_iterator valueBegin = begin;
+  Buffer::const_iterator valueEnd = end;
 
-  m_type = tlv::readType(m_value_begin, m_value_end);
-  uint64_t length = tlv::readVarNumber(m_value_begin, m_value_end);
+  m_type = tlv::readType(valueBegin, valueEnd);
+  uint64_t length = tlv::readVarNumber(valueBegin, valueEnd);
   if (verifyLength) {
-    if (length != static_cast<uint64_t>(std::distance(m_value_begin, m_value_end))) {
+    if (length != static_cast<uint64_t>(std::distance(valueBegin, valueEnd))) {
       BOOST_THROW_EXCEPTION(tlv::Error("TLV length doesn't match buffer length"));
     }
   }
+
+  setRange(begin, end, valueBegin, valueEnd);
 }
 
 Block::Block(const uint8_t* buffer, size_t maxlength)
@@ -159,12 +254,8 @@ Block::Block(const uint8_t* buffer, size_t maxlength)
 
   m_buffer = make_shared<Buffer>(buffer, (tmp_begin - buffer) + length);
 
-  m_begin = m_buffer->begin();
-  m_end = m_buffer->end();
-  m_size = m_end - m_begin;
-
-  m_value_begin = m_buffer->begin() + (tmp_begin - buffer);
-  m_value_end   = m_buffer->end();
+  Buffer::const_iterator end = m_buffer->begin() + (tmp_begin - buffer) + length;
+  setRange(m_buffer->begin(), end, m_buffer->begin() + (tmp_begin - buffer), end);
 }
 
 Block::Block(const void* bufferX, size_t maxlength)
@@ -184,74 +275,118 @@ Block::Block(const void* bufferX, size_t maxlength)
 
   m_buffer = make_shared<Buffer>(buffer, (tmp_begin - buffer) + length);
 
-  m_begin = m_buffer->begin();
-  m_end = m_buffer->end();
-  m_size = m_end - m_begin;
-
-  m_value_begin = m_buffer->begin() + (tmp_begin - buffer);
-  m_value_end   = m_buffer->end();
+  Buffer::const_iterator end = m_buffer->begin() + (tmp_begin - buffer) + length;
+  setRange(m_buffer->begin(), end, m_buffer->begin() + (tmp_begin - buffer), end);
 }
 
 Block::Block(uint32_t type)
   : m_type(type)
+  , m_size(static_cast<uint32_t>(tlv::sizeOfVarNumber(type) + tlv::sizeOfVarNumber(0)))
 {
 }
 
 Block::Block(uint32_t type, const ConstBufferPtr& value)
-  : m_buffer(value)
-  , m_type(type)
-  , m_begin(m_buffer->end())
-  , m_end(m_buffer->end())
-  , m_value_begin(m_buffer->begin())
-  , m_value_end(m_buffer->end())
+  : m_type(type)
+  , m_buffer(value)
 {
-  m_size = tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(value_size()) + value_size();
+  setRange(m_buffer->end(), m_buffer->end(), m_buffer->begin(), m_buffer->end());
+  m_size = toOffset(tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(value_size()) +
+                    value_size());
 }
 
 Block::Block(uint32_t type, const Block& value)
-  : m_buffer(value.m_buffer)
-  , m_type(type)
-  , m_begin(m_buffer->end())
-  , m_end(m_buffer->end())
-  , m_value_begin(value.begin())
-  , m_value_end(value.end())
+  : m_type(type)
+  , m_buffer(value.m_buffer)
 {
-  m_size = tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(value_size()) + value_size();
+  setRange(m_buffer->end(), m_buffer->end(), value.begin(), value.end());
+  m_size = toOffset(tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(value_size()) +
+                    value_size());
+}
+
+void
+Block::setRange(const Buffer::const_iterator& begin, const Buffer::const_iterator& end,
+                const Buffer::const_iterator& valueBegin, const Buffer::const_iterator& valueEnd)
+{
+  Buffer::const_iterator base = m_buffer->begin();
+
+  m_base = m_buffer->data();
+  m_begin = toOffset(begin - base);
+  m_end = toOffset(end - base);
+  m_size = m_end - m_begin;
+  m_value_begin = toOffset(valueBegin - base);
+  m_value_end = toOffset(valueEnd - base);
+}
+
+/** @brief Read VAR-NUMBER octets from @p streamBuf, appending them to @p header
+ *  @return false if the stream ends before the VAR-NUMBER is complete
+ */
+static bool
+readVarNumberOctets(std::streambuf& streamBuf, uint8_t* header, size_t& headerSize)
+{
+  std::streambuf::int_type firstOctet = streamBuf.sbumpc();
+  if (std::streambuf::traits_type::eq_int_type(firstOctet, std::streambuf::traits_type::eof()))
+    return false;
+
+  header[headerSize++] = static_cast<uint8_t>(firstOctet);
+  if (firstOctet < 253)
+    return true;
+
+  std::streamsize size = std::streamsize(1) << (firstOctet - 252);
+  std::streamsize nRead = streamBuf.sgetn(reinterpret_cast<char*>(header + headerSize), size);
+  headerSize += static_cast<size_t>(nRead);
+  return nRead == size;
 }
 
 Block
 Block::fromStream(std::istream& is)
 {
-  std::istream_iterator<uint8_t> begin(is >> std::noskipws);
-  std::istream_iterator<uint8_t> end;
+  std::istream::sentry sentry(is, true);
+  if (!sentry)
+    BOOST_THROW_EXCEPTION(tlv::Error("Empty buffer during TLV processing"));
+
+  std::streambuf& streamBuf = *is.rdbuf();
+
+  // TLV-TYPE and TLV-LENGTH are at most 9 octets each
+  uint8_t header[18];
+  size_t headerSize = 0;
+  if (!readVarNumberOctets(streamBuf, header, headerSize) ||
+      !readVarNumberOctets(streamBuf, header, headerSize))
+    {
+      is.setstate(std::ios::eofbit | std::ios::failbit);
+      BOOST_THROW_EXCEPTION(tlv::Error("Insufficient data during TLV processing"));
+    }
 
+  const uint8_t* begin = header;
+  const uint8_t* end = header + headerSize;
   uint32_t type = tlv::readType(begin, end);
   uint64_t length = tlv::readVarNumber(begin, end);
 
-  if (length == 0) {
-    return makeEmptyBlock(type);
-  }
-
   if (length > MAX_SIZE_OF_BLOCK_FROM_STREAM)
     BOOST_THROW_EXCEPTION(tlv::Error("Length of block from stream is too large"));
 
-  // We may still have some problem here, if some exception happens,
-  // we may completely lose all the bytes extracted from the stream.
-
-  char buf[MAX_SIZE_OF_BLOCK_FROM_STREAM];
-  buf[0] = *begin;
-  is.read(buf + 1, length - 1);
+  // the value is read straight into the buffer that becomes the Block's storage
+  BufferPtr buffer = make_shared<Buffer>(headerSize + length);
+  std::copy(header, header + headerSize, buffer->begin());
 
-  if (length != static_cast<uint64_t>(is.gcount()) + 1) {
+  std::streamsize nRead = streamBuf.sgetn(reinterpret_cast<char*>(buffer->buf()) + headerSize,
+                                          static_cast<std::streamsize>(length));
+  if (nRead != static_cast<std::streamsize>(length)) {
+    is.setstate(std::ios::eofbit | std::ios::failbit);
     BOOST_THROW_EXCEPTION(tlv::Error("Not enough data in the buffer to fully parse TLV"));
   }
 
-  return makeBinaryBlock(type, buf, length);
+  Buffer::const_iterator wireEnd = buffer->begin() + headerSize + length;
+  return Block(buffer, type,
+               buffer->begin(), wireEnd,
+               buffer->begin() + headerSize, wireEnd);
 }
 
 std::tuple<bool, Block>
 Block::fromBuffer(ConstBufferPtr buffer, size_t offset)
 {
+  if (offset > buffer->size())
+    return std::make_tuple(false, Block());
+
   Buffer::const_iterator tempBegin = buffer->begin() + offset;
 
   uint32_t type;
@@ -272,6 +407,42 @@ Block::fromBuffer(ConstBufferPtr buffer, size_t offset)
                                      tempBegin, tempBegin + length));
 }
 
+std::tuple<bool, Block>
+Block::fromBuffer(ConstBufferPtr buffer)
+{
+  return fromBuffer(buffer, buffer->begin(), buffer->end(), true);
+}
+
+std::tuple<bool, Block>
+Block::fromBuffer(ConstBufferPtr buffer,
+                  const Buffer::const_iterator& begin, const Buffer::const_iterator& end,
+                  bool verifyLength/* = true*/)
+{
+  if (!(buffer->begin() <= begin && begin <= end && end <= buffer->end()))
+    return std::make_tuple(false, Block());
+
+  Buffer::const_iterator tempBegin = begin;
+
+  uint32_t type;
+  bool isOk = tlv::readType(tempBegin, end, type);
+  if (!isOk)
+    return std::make_tuple(false, Block());
+
+  uint64_t length;
+  isOk = tlv::readVarNumber(tempBegin, end, length);
+  if (!isOk)
+    return std::make_tuple(false, Block());
+
+  if (verifyLength ? length != static_cast<uint64_t>(end - tempBegin)
+                   : length > static_cast<uint64_t>(end - tempBegin))
+    return std::make_tuple(false, Block());
+
+  // like the throwing constructors, the Block spans the whole given range
+  return std::make_tuple(true, Block(buffer, type,
+                                     begin, end,
+                                     tempBegin, end));
+}
+
 std::tuple<bool, Block>
 Block::fromBuffer(const uint8_t* buffer, size_t maxSize)
 {
@@ -291,64 +462,143 @@ Block::fromBuffer(const uint8_t* buffer, size_t maxSize)
   if (length > static_cast<uint64_t>(tempEnd - tempBegin))
     return std::make_tuple(false, Block());
 
-  BufferPtr sharedBuffer = make_shared<Buffer>(buffer, tempBegin + length);
+  BufferPtr sharedBuffer = make_shared<Buffer>(buffer, (tempBegin - buffer) + length);
+  Buffer::const_iterator end = sharedBuffer->begin() + (tempBegin - buffer) + length;
   return std::make_tuple(true,
          Block(sharedBuffer, type,
-               sharedBuffer->begin(), sharedBuffer->end(),
-               sharedBuffer->begin() + (tempBegin - buffer), sharedBuffer->end()));
+               sharedBuffer->begin(), end,
+               sharedBuffer->begin() + (tempBegin - buffer), end));
 }
 
 void
 Block::reset()
 {
   m_buffer.reset(); // reset of the shared_ptr
-  m_subBlocks.clear(); // remove all parsed subelements
+  // remove all parsed subelements
+  delete m_elements.exchange(nullptr, std::memory_order_relaxed);
 
   m_type = std::numeric_limits<uint32_t>::max();
-  m_begin = m_end = m_value_begin = m_value_end = Buffer::const_iterator();
+  m_base = nullptr;
+  m_begin = m_end = m_value_begin = m_value_end = 0;
 }
 
 void
 Block::resetWire()
 {
+  // keep subblocks, which must be created before the wire they refer to is released
+  materializeElements();
+
+  // the parse index refers to the released wire, so copies must copy the subblocks instead;
+  // the size is kept, as it is determined by the subblocks, unless the value is not parsed
+  Elements* elements = m_elements.load(std::memory_order_relaxed);
+  if (elements != nullptr) {
+    elements->index.clear();
+    elements->typeIndex.clear();
+    elements->hasTypeIndex = false;
+    if (elements->blocks.empty())
+      elements->valueSize = 0;
+    else if (hasWire())
+      elements->valueSize = value_size();
+  }
+  if (!empty() && (elements == nullptr || elements->blocks.empty()))
+    m_size = static_cast<uint32_t>(tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(0));
+
   m_buffer.reset(); // reset of the shared_ptr
-  // keep subblocks
 
   // keep type
-  m_begin = m_end = m_value_begin = m_value_end = Buffer::const_iterator();
+  m_base = nullptr;
+  m_begin = m_end = m_value_begin = m_value_end = 0;
 }
 
 void
 Block::parse() const
 {
-  if (!m_subBlocks.empty() || value_size() == 0)
-    return;
+  if (!tryParse())
+    BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
+}
 
-  Buffer::const_iterator begin = value_begin();
-  Buffer::const_iterator end = value_end();
+bool
+Block::tryParse() const
+{
+  // existing subelement storage, whether published by parse() or built by modifiers,
+  // already describes the subelements
+  if (m_elements.load(std::memory_order_acquire) != nullptr || value_size() == 0)
+    return true;
+
+  // only the headers are recorded; sub elements are created by materializeElements()
+  boost::container::small_vector<tlv::ElementHeader, SCAN_INLINE_HEADERS> headers;
+  bool isOk = m_buffer->isReadable(value() + value_size(), 8) ?
+              tlv::scanElementsPadded(value(), value() + value_size(), headers) :
+              tlv::scanElements(value_begin(), value_end(), headers);
+  if (!isOk)
+    return false;
+
+  unique_ptr<Elements> elements(new Elements);
+  elements->index.assign(headers.begin(), headers.end());
+  if (headers.size() >= TYPE_INDEX_MIN_ELEMENTS)
+    indexTypes(*elements, elements->index);
+
+  // publish the index, unless a concurrent reader has already published an identical one
+  Elements* expected = nullptr;
+  if (m_elements.compare_exchange_strong(expected, elements.get(),
+                                         std::memory_order_acq_rel, std::memory_order_acquire))
+    elements.release();
+  return true;
+}
 
-  while (begin != end)
-    {
-      Buffer::const_iterator element_begin = begin;
+const Block::element_container&
+Block::elements() const
+{
+  static const element_container noElements;
 
-      uint32_t type = tlv::readType(begin, end);
-      uint64_t length = tlv::readVarNumber(begin, end);
+  materializeElements();
+  Elements* elements = m_elements.load(std::memory_order_acquire);
+  return elements == nullptr ? noElements : elements->blocks;
+}
 
-      if (length > static_cast<uint64_t>(end - begin))
-        {
-          m_subBlocks.clear();
-          BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
-        }
-      Buffer::const_iterator element_end = begin + length;
+Block::element_container&
+Block::getSubBlocks()
+{
+  Elements* elements = m_elements.load(std::memory_order_relaxed);
+  if (elements == nullptr) {
+    elements = new Elements;
+    m_elements.store(elements, std::memory_order_relaxed);
+  }
+  else {
+    // subelements are about to be modified, so the indexes no longer describe them
+    materializeElements();
+    elements->index.clear();
+    elements->typeIndex.clear();
+    elements->hasTypeIndex = false;
+  }
 
-      m_subBlocks.push_back(Block(m_buffer,
-                                  type,
-                                  element_begin, element_end,
-                                  begin, element_end));
+  return elements->blocks;
+}
 
-      begin = element_end;
-      // don't do recursive parsing, just the top level
-    }
+void
+Block::materializeElements() const
+{
+  Elements* elements = m_elements.load(std::memory_order_acquire);
+  if (elements == nullptr || elements->index.empty())
+    return;
+
+  std::call_once(elements->materializeOnce, [this, elements] {
+      Buffer::const_iterator begin = value_begin();
+      element_container& subBlocks = elements->blocks;
+
+      subBlocks.reserve(elements->index.size());
+      for (const tlv::ElementHeader& header : elements->index)
+        {
+          Buffer::const_iterator element_value_begin = begin + header.valueOffset;
+          Buffer::const_iterator element_end = element_value_begin + header.length;
+
+          subBlocks.push_back(Block(m_buffer,
+                                    header.type,
+                                    begin + header.offset, element_end,
+                                    element_value_begin, element_end));
+          // don't do recursive parsing, just the top level
+        }
+    });
 }
 
 void
@@ -357,80 +607,222 @@ Block::encode()
   if (hasWire())
     return;
 
-  OBufferStream os;
-  tlv::writeVarNumber(os, type());
+  // the exact size of the whole tree is known up front, so the buffer is allocated once
+  size_t wireSize = size();
+  BufferPtr buffer = make_shared<Buffer>(wireSize);
+  prependTo(buffer, buffer->data() + wireSize);
+}
 
-  if (hasValue())
+uint8_t*
+Block::prependTo(const ConstBufferPtr& buffer, uint8_t* end)
+{
+  if (hasWire())
     {
-      tlv::writeVarNumber(os, value_size());
-      os.write(reinterpret_cast<const char*>(value()), value_size());
+      uint8_t* begin = end - m_size;
+      std::copy(m_base + m_begin, m_base + m_end, begin);
+      rebase(buffer, begin);
+      return begin;
     }
-  else if (m_subBlocks.size() == 0)
+
+  Elements* elements = m_elements.load(std::memory_order_relaxed);
+  uint8_t* pos = end;
+  if (hasValue())
     {
-      tlv::writeVarNumber(os, 0);
+      pos -= value_size();
+      std::copy(m_base + m_value_begin, m_base + m_value_end, pos);
     }
   else
     {
-      size_t valueSize = 0;
-      for (element_const_iterator i = m_subBlocks.begin(); i != m_subBlocks.end(); ++i) {
-        valueSize += i->size();
-      }
-
-      tlv::writeVarNumber(os, valueSize);
-
-      for (element_const_iterator i = m_subBlocks.begin(); i != m_subBlocks.end(); ++i) {
-        if (i->hasWire())
-          os.write(reinterpret_cast<const char*>(i->wire()), i->size());
-        else if (i->hasValue()) {
-          tlv::writeVarNumber(os, i->type());
-          tlv::writeVarNumber(os, i->value_size());
-          os.write(reinterpret_cast<const char*>(i->value()), i->value_size());
-        }
-        else
-          BOOST_THROW_EXCEPTION(Error("Underlying value buffer is empty"));
+      // sub elements are encoded recursively, and refer to the new buffer afterwards;
+      // without wire encoding, there is no parse index, so the sub elements are authoritative
+      if (elements != nullptr) {
+        for (auto i = elements->blocks.rbegin(); i != elements->blocks.rend(); ++i)
+          pos = i->prependTo(buffer, pos);
       }
     }
 
+  uint8_t* valueBegin = pos;
+  size_t valueSize = end - valueBegin;
+  pos -= tlv::sizeOfVarNumber(valueSize);
+  tlv::writeVarNumber(pos, valueSize);
+  pos -= tlv::sizeOfVarNumber(m_type);
+  tlv::writeVarNumber(pos, m_type);
+
   // now assign correct block
+  m_buffer = buffer;
+  Buffer::const_iterator base = m_buffer->begin();
+  setRange(base + (pos - m_buffer->data()), base + (end - m_buffer->data()),
+           base + (valueBegin - m_buffer->data()), base + (end - m_buffer->data()));
+
+  // the encoded Block is usually shared next, so restore the index that modifiers dropped;
+  // its size is that of the wire encoding again, which later modifications splice
+  if (elements != nullptr) {
+    elements->hasMutableIterators = false;
+    if (!elements->hasTypeIndex && elements->blocks.size() >= TYPE_INDEX_MIN_ELEMENTS)
+      indexTypes(*elements, elements->blocks);
+  }
+
+  return pos;
+}
+
+void
+Block::rebase(const ConstBufferPtr& buffer, const uint8_t* wire)
+{
+  const uint8_t* oldWire = m_base + m_begin;
+  const uint8_t* oldEnd = m_base + m_end;
+
+  m_buffer = buffer;
+  m_base = buffer->data();
+  uint32_t begin = toOffset(wire - m_base);
+  toOffset(begin + static_cast<size_t>(m_size));
+  m_value_begin = begin + (m_value_begin - m_begin);
+  m_value_end = begin + (m_value_end - m_begin);
+  m_begin = begin;
+  m_end = begin + m_size;
+
+  // created sub elements lie within the wire encoding; parse indexes are relative to the value
+  Elements* elements = m_elements.load(std::memory_order_relaxed);
+  if (elements == nullptr)
+    return;
 
-  m_buffer = os.buf();
-  m_begin = m_buffer->begin();
-  m_end   = m_buffer->end();
-  m_size  = m_end - m_begin;
+  for (Block& element : elements->blocks) {
+    if (element.hasWire() &&
+        oldWire <= element.wire() && element.wire() + element.size() <= oldEnd)
+      element.rebase(buffer, wire + (element.wire() - oldWire));
+  }
+}
 
-  m_value_begin = m_buffer->begin();
-  m_value_end   = m_buffer->end();
+static uint32_t
+getType(const tlv::ElementHeader& header)
+{
+  return header.type;
+}
 
-  tlv::readType(m_value_begin, m_value_end);
-  tlv::readVarNumber(m_value_begin, m_value_end);
+static uint32_t
+getType(const Block& block)
+{
+  return block.type();
+}
+
+template<class Container>
+void
+Block::indexTypes(Elements& elements, const Container& container)
+{
+  elements.typeIndex.clear();
+  elements.typeIndex.reserve(container.size());
+  elements.smallTypes.reset();
+
+  uint32_t position = 0;
+  for (const auto& element : container) {
+    uint32_t type = getType(element);
+    elements.typeIndex.emplace_back(type, position++);
+    if (type < elements.smallTypes.size())
+      elements.smallTypes.set(type);
+  }
+
+  std::sort(elements.typeIndex.begin(), elements.typeIndex.end());
+  elements.hasTypeIndex = true;
 }
 
 const Block&
 Block::get(uint32_t type) const
 {
   element_const_iterator it = this->find(type);
-  if (it != m_subBlocks.end())
+  if (it != elements_end())
     return *it;
 
   BOOST_THROW_EXCEPTION(Error("(Block::get) Requested a non-existed type [" +
-                              boost::lexical_cast<std::string>(type) + "] from Block"));
+                              std::to_string(type) + "] from Block"));
 }
 
 Block::element_const_iterator
 Block::find(uint32_t type) const
 {
-  return std::find_if(m_subBlocks.begin(), m_subBlocks.end(),
-                      [type] (const Block& subBlock) { return subBlock.type() == type; });
+  return find(type, 0);
+}
+
+Block::element_const_iterator
+Block::find(uint32_t type, size_t index) const
+{
+  const element_container& subBlocks = elements();
+
+  const Elements* elements = m_elements.load(std::memory_order_acquire);
+  if (elements != nullptr && elements->hasTypeIndex) {
+    if (type < elements->smallTypes.size() && !elements->smallTypes[type])
+      return subBlocks.end();
+
+    auto it = std::lower_bound(elements->typeIndex.begin(), elements->typeIndex.end(),
+                               std::make_pair(type, uint32_t(0)));
+    if (static_cast<size_t>(elements->typeIndex.end() - it) <= index ||
+        it[index].first != type)
+      return subBlocks.end();
+
+    return subBlocks.begin() + it[index].second;
+  }
+
+  for (element_const_iterator i = subBlocks.begin(); i != subBlocks.end(); ++i) {
+    if (i->type() == type && index-- == 0)
+      return i;
+  }
+  return subBlocks.end();
+}
+
+std::tuple<bool, Block>
+Block::findInWire(uint32_t type) const
+{
+  if (!hasWire()) {
+    element_const_iterator it = find(type);
+    if (it == elements_end())
+      return std::make_tuple(false, Block());
+    return std::make_tuple(true, *it);
+  }
+
+  BlockView element = BlockPath::findElement(value(), value() + value_size(), type);
+  if (element.empty())
+    return std::make_tuple(false, Block());
+
+  return std::make_tuple(true, element.toBlock(*this));
+}
+
+size_t
+Block::count(uint32_t type) const
+{
+  const Elements* elements = m_elements.load(std::memory_order_acquire);
+  if (elements != nullptr && elements->hasTypeIndex) {
+    if (type < elements->smallTypes.size() && !elements->smallTypes[type])
+      return 0;
+
+    auto first = std::lower_bound(elements->typeIndex.begin(), elements->typeIndex.end(),
+                                  std::make_pair(type, uint32_t(0)));
+    auto last = std::upper_bound(first, elements->typeIndex.end(),
+                                 std::make_pair(type, std::numeric_limits<uint32_t>::max()));
+    return last - first;
+  }
+
+  const element_container& subBlocks = this->elements();
+  return std::count_if(subBlocks.begin(), subBlocks.end(),
+                       [type] (const Block& subBlock) { return subBlock.type() == type; });
 }
 
 void
 Block::remove(uint32_t type)
 {
-  resetWire();
+  if (count(type) == 0)
+    return;
+
+  ptrdiff_t sizeDelta = 0;
+  for (const Block& element : elements()) {
+    if (element.type() == type)
+      sizeDelta -= element.size();
+  }
+  bool isSplicing = prepareModification();
 
-  auto it = std::remove_if(m_subBlocks.begin(), m_subBlocks.end(),
+  element_container& subBlocks = getSubBlocks();
+  auto it = std::remove_if(subBlocks.begin(), subBlocks.end(),
                            [type] (const Block& subBlock) { return subBlock.type() == type; });
-  m_subBlocks.resize(it - m_subBlocks.begin());
+  subBlocks.resize(it - subBlocks.begin());
+
+  completeModification(isSplicing, sizeDelta);
 }
 
 Block
@@ -479,7 +871,7 @@ Block::begin() const
   if (!hasWire())
     BOOST_THROW_EXCEPTION(Error("Underlying wire buffer is empty"));
 
-  return m_begin;
+  return m_buffer->begin() + m_begin;
 }
 
 Buffer::const_iterator
@@ -488,7 +880,7 @@ Block::end() const
   if (!hasWire())
     BOOST_THROW_EXCEPTION(Error("Underlying wire buffer is empty"));
 
-  return m_end;
+  return m_buffer->begin() + m_end;
 }
 
 const uint8_t*
@@ -497,110 +889,338 @@ Block::wire() const
   if (!hasWire())
     BOOST_THROW_EXCEPTION(Error("(Block::wire) Underlying wire buffer is empty"));
 
-  return &*m_begin;
+  return m_base + m_begin;
 }
 
 size_t
 Block::size() const
 {
-  if (hasWire() || hasValue()) {
+  if (empty())
+    BOOST_THROW_EXCEPTION(Error("Block size cannot be determined (undefined block size)"));
+
+  return encodedSize();
+}
+
+size_t
+Block::encodedSize() const
+{
+  const Elements* elements = m_elements.load(std::memory_order_acquire);
+  if (hasWire() || hasValue() || elements == nullptr || !elements->hasMutableIterators)
     return m_size;
+
+  size_t valueSize = 0;
+  for (const Block& element : elements->blocks) {
+    valueSize += element.encodedSize();
   }
-  else
-    BOOST_THROW_EXCEPTION(Error("Block size cannot be determined (undefined block size)"));
+  return tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(valueSize) + valueSize;
 }
 
-bool
-Block::hasValue() const
+Block::element_iterator
+Block::erase(Block::element_const_iterator position)
 {
-  return static_cast<bool>(m_buffer);
+  element_container::difference_type index = std::distance(elements_begin(), position);
+  prepareMutableIterator();
+  eraseElement(elements_begin() + index);
+  return getSubBlocks().begin() + index;
 }
 
-const uint8_t*
-Block::value() const
+Block::element_iterator
+Block::erase(Block::element_const_iterator first, Block::element_const_iterator last)
 {
-  if (!hasValue())
-    return 0;
+  element_container::difference_type index = std::distance(elements_begin(), first);
+  prepareMutableIterator();
+  eraseElements(elements_begin() + index,
+                elements_begin() + (index + std::distance(first, last)));
+  return getSubBlocks().begin() + index;
+}
 
-  return &*m_value_begin;
+void
+Block::eraseElement(Block::element_const_iterator position)
+{
+  // the storage may change, so the position is converted to an index first
+  element_container::difference_type index = std::distance(elements_begin(), position);
+  ptrdiff_t sizeDelta = -static_cast<ptrdiff_t>(position->size());
+  bool isSplicing = prepareModification();
+
+  element_container& subBlocks = getSubBlocks();
+  subBlocks.erase(subBlocks.begin() + index);
+
+  completeModification(isSplicing, sizeDelta);
 }
 
-size_t
-Block::value_size() const
+void
+Block::eraseElements(Block::element_const_iterator first, Block::element_const_iterator last)
 {
-  if (!hasValue())
-    return 0;
+  // the storage may change, so the positions are converted to indexes first
+  element_container::difference_type firstIndex = std::distance(elements_begin(), first);
+  element_container::difference_type lastIndex = std::distance(elements_begin(), last);
+  ptrdiff_t sizeDelta = 0;
+  for (element_const_iterator i = first; i != last; ++i) {
+    sizeDelta -= i->size();
+  }
+  bool isSplicing = prepareModification();
 
-  return m_value_end - m_value_begin;
+  element_container& subBlocks = getSubBlocks();
+  subBlocks.erase(subBlocks.begin() + firstIndex, subBlocks.begin() + lastIndex);
+
+  completeModification(isSplicing, sizeDelta);
 }
 
-Block::element_iterator
-Block::erase(Block::element_const_iterator position)
+void
+Block::reserveElements()
 {
-  resetWire();
+  element_container& subBlocks = getSubBlocks();
+  if (subBlocks.capacity() == 0)
+    subBlocks.reserve(ELEMENTS_CAPACITY);
+}
+
+void
+Block::push_back(const Block& element)
+{
+  ptrdiff_t sizeDelta = element.size();
+  bool isSplicing = prepareModification();
 
-#ifdef NDN_CXX_HAVE_VECTOR_INSERT_ERASE_CONST_ITERATOR
-  return m_subBlocks.erase(position);
-#else
-  element_iterator it = m_subBlocks.begin();
-  std::advance(it, std::distance(m_subBlocks.cbegin(), position));
-  return m_subBlocks.erase(it);
-#endif
+  reserveElements();
+  getSubBlocks().push_back(element);
+
+  completeModification(isSplicing, sizeDelta);
 }
 
 Block::element_iterator
-Block::erase(Block::element_const_iterator first, Block::element_const_iterator last)
+Block::insert(Block::element_const_iterator pos, const Block& element)
 {
-  resetWire();
+  element_container::difference_type index = std::distance(elements_begin(), pos);
+  prepareMutableIterator();
+  insertElement(elements_begin() + index, element);
+  return getSubBlocks().begin() + index;
+}
+
+void
+Block::insertElement(Block::element_const_iterator pos, const Block& element)
+{
+  // pos may point into storage that is about to be created or reallocated, so it is
+  // converted to an index within the container it was taken from first
+  element_container::difference_type index = std::distance(elements_begin(), pos);
+  ptrdiff_t sizeDelta = element.size();
+  bool isSplicing = prepareModification();
+
+  reserveElements();
+  element_container& subBlocks = getSubBlocks();
+  subBlocks.insert(subBlocks.begin() + index, element);
 
-#ifdef NDN_CXX_HAVE_VECTOR_INSERT_ERASE_CONST_ITERATOR
-  return m_subBlocks.erase(first, last);
-#else
-  element_iterator itStart = m_subBlocks.begin();
-  element_iterator itEnd = m_subBlocks.begin();
-  std::advance(itStart, std::distance(m_subBlocks.cbegin(), first));
-  std::advance(itEnd, std::distance(m_subBlocks.cbegin(), last));
-  return m_subBlocks.erase(itStart, itEnd);
-#endif
+  completeModification(isSplicing, sizeDelta);
 }
 
 void
-Block::push_back(const Block& element)
+Block::patch(const BlockPath& path, const uint8_t* value, size_t valueSize)
+{
+  BlockView target = hasWire() ? path.evaluate(*this) : BlockView();
+  if (target.empty() || target.value_size() != valueSize) {
+    patchElements(path, 0, value, valueSize);
+    return;
+  }
+
+  size_t offset = target.value_begin() - m_base;
+  if (m_buffer.use_count() > countOwnReferences()) {
+    offset -= m_begin;
+    detachBuffer();
+  }
+
+  // the buffer is not shared with other Blocks, so it can be written despite being const
+  std::copy(value, value + valueSize, const_cast<uint8_t*>(m_base) + offset);
+
+  // a created subelement for the target sees the new value, but must parse it again
+  Block* block = this;
+  for (size_t step = 0; step < path.size(); ++step) {
+    const Elements* elements = block->m_elements.load(std::memory_order_relaxed);
+    if (elements == nullptr || elements->blocks.empty())
+      return;
+    block = const_cast<Block*>(&*block->find(path[step].type, path[step].index));
+  }
+  delete block->m_elements.exchange(nullptr, std::memory_order_relaxed);
+}
+
+long
+Block::countOwnReferences() const
+{
+  long nReferences = 1;
+  const Elements* elements = m_elements.load(std::memory_order_relaxed);
+  if (elements != nullptr) {
+    for (const Block& element : elements->blocks) {
+      if (element.m_buffer == m_buffer)
+        nReferences += element.countOwnReferences();
+    }
+  }
+  return nReferences;
+}
+
+void
+Block::patchElements(const BlockPath& path, size_t step, const uint8_t* value, size_t valueSize)
+{
+  if (hasWire())
+    parse();
+
+  element_const_iterator element = find(path[step].type, path[step].index);
+  if (element == elements_end())
+    BOOST_THROW_EXCEPTION(Error("(Block::patch) Requested a non-existed type [" +
+                                std::to_string(path[step].type) + "] from Block"));
+
+  Block replacement;
+  if (step + 1 < path.size()) {
+    replacement = *element;
+    replacement.patchElements(path, step + 1, value, valueSize);
+  }
+  else {
+    replacement = makeBinaryBlock(path[step].type, value, valueSize);
+  }
+
+  size_t position = std::distance(elements_begin(), element);
+  ptrdiff_t sizeDelta = static_cast<ptrdiff_t>(replacement.size()) -
+                        static_cast<ptrdiff_t>(element->size());
+  bool isSplicing = prepareModification();
+  getSubBlocks()[position] = std::move(replacement);
+  completeModification(isSplicing, sizeDelta);
+}
+
+void
+Block::detachBuffer()
 {
+  BufferPtr buffer = make_shared<Buffer>(wire(), size());
+
+  // subelements would share the copy, so they are created again on demand, from the parse
+  // index if there is one, or else from an index built by parsing the copy
+  Elements* elements = m_elements.load(std::memory_order_relaxed);
+  bool isParsed = elements != nullptr;
+  Elements* indexOnly = nullptr;
+  if (isParsed && !elements->index.empty())
+    indexOnly = copyElements(elements);
+  delete m_elements.exchange(indexOnly, std::memory_order_relaxed);
+
+  rebase(buffer, buffer->data());
+  if (isParsed)
+    parse();
+}
+
+bool
+Block::prepareModification()
+{
+  // splicing needs the subelements of the old wire encoding, and cannot see modifications
+  // made through iterators that were returned earlier, so these cases reset the Block
+  Elements* elements = m_elements.load(std::memory_order_relaxed);
+  bool isParsed = elements != nullptr || value_size() == 0;
+  if (hasWire() && isParsed && (elements == nullptr || !elements->hasMutableIterators))
+    return true;
+
   resetWire();
-  m_subBlocks.push_back(element);
+  return false;
 }
 
-Block::element_iterator
-Block::insert(Block::element_const_iterator pos, const Block& element)
+void
+Block::prepareMutableIterator()
 {
   resetWire();
+  getSubBlocks();
+  m_elements.load(std::memory_order_relaxed)->hasMutableIterators = true;
+}
+
+void
+Block::completeModification(bool isSplicing, ptrdiff_t sizeDelta)
+{
+  if (isSplicing) {
+    spliceWire();
+    return;
+  }
 
-#ifdef NDN_CXX_HAVE_VECTOR_INSERT_ERASE_CONST_ITERATOR
-  return m_subBlocks.insert(pos, element);
-#else
-  element_iterator it = m_subBlocks.begin();
-  std::advance(it, std::distance(m_subBlocks.cbegin(), pos));
-  return m_subBlocks.insert(it, element);
-#endif
+  Elements* elements = m_elements.load(std::memory_order_relaxed);
+  elements->valueSize += sizeDelta;
+  m_size = toOffset(tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(elements->valueSize) +
+                    elements->valueSize);
+}
+
+void
+Block::spliceWire()
+{
+  element_container& subBlocks = m_elements.load(std::memory_order_relaxed)->blocks;
+
+  size_t valueSize = 0;
+  for (const Block& element : subBlocks) {
+    valueSize += element.size();
+  }
+  size_t headerSize = tlv::sizeOfVarNumber(m_type) + tlv::sizeOfVarNumber(valueSize);
+  BufferPtr buffer = make_shared<Buffer>(headerSize + valueSize);
+
+  uint8_t* pos = buffer->data();
+  pos += tlv::writeVarNumber(pos, m_type);
+  pos += tlv::writeVarNumber(pos, valueSize);
+  uint8_t* valueBegin = pos;
+
+  // sub elements that are adjacent in the same source buffer, such as the unchanged ranges
+  // of the old wire encoding, are copied at once
+  const Buffer* runBuffer = nullptr;
+  const uint8_t* runBegin = nullptr;
+  const uint8_t* runEnd = nullptr;
+  uint8_t* runDestination = pos;
+  for (Block& element : subBlocks) {
+    if (element.hasWire()) {
+      if (element.m_buffer.get() != runBuffer || element.wire() != runEnd) {
+        std::copy(runBegin, runEnd, runDestination);
+        runBuffer = element.m_buffer.get();
+        runBegin = element.wire();
+        runDestination = pos;
+      }
+      runEnd = element.wire() + element.size();
+      pos += element.size();
+    }
+    else {
+      std::copy(runBegin, runEnd, runDestination);
+      runBuffer = nullptr;
+      runBegin = runEnd = nullptr;
+
+      pos += element.size();
+      element.prependTo(buffer, pos);
+    }
+  }
+  std::copy(runBegin, runEnd, runDestination);
+
+  // sub elements that were copied refer to the new buffer only after all copies are done,
+  // because they may own their source buffer
+  pos = valueBegin;
+  for (Block& element : subBlocks) {
+    if (element.m_buffer != buffer)
+      element.rebase(buffer, pos);
+    pos += element.size();
+  }
+
+  m_buffer = buffer;
+  Buffer::const_iterator end = m_buffer->begin() + (pos - m_buffer->data());
+  setRange(m_buffer->begin(), end, m_buffer->begin() + (valueBegin - m_buffer->data()), end);
+
+  Elements* elements = m_elements.load(std::memory_order_relaxed);
+  if (subBlocks.size() >= TYPE_INDEX_MIN_ELEMENTS)
+    indexTypes(*elements, subBlocks);
 }
 
 Block::element_const_iterator
 Block::elements_begin() const
 {
-  return m_subBlocks.begin();
+  return elements().begin();
 }
 
 Block::element_const_iterator
 Block::elements_end() const
 {
-  return m_subBlocks.end();
+  return elements().end();
 }
 
 size_t
 Block::elements_size() const
 {
-  return m_subBlocks.size();
+  Elements* elements = m_elements.load(std::memory_order_acquire);
+  if (elements == nullptr)
+    return 0;
+
+  // blocks may be being created from a non-empty index by another reader
+  return elements->index.empty() ? elements->blocks.size() : elements->index.size();
 }
 
 bool
@@ -613,7 +1233,7 @@ bool
 Block::operator==(const Block& other) const
 {
   return this->size() == other.size() &&
-         std::equal(this->begin(), this->end(), other.begin());
+         std::memcmp(this->wire(), other.wire(), this->size()) == 0;
 }
 
 } // namespace ndn
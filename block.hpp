@@ -30,6 +30,19 @@
 #include "tlv.hpp"
 #include "encoding-buffer-fwd.hpp"
 
+#include <atomic>
+#include <bitset>
+#include <mutex>
+
+/** @brief Number of subelements for which a Block reserves storage when the first one is added
+ *
+ *  The default covers the top level of typical Interest and Data packets, which have up to
+ *  seven elements, so that building them with push_back() does not reallocate.
+ */
+#ifndef NDN_ENCODING_BLOCK_ELEMENTS_CAPACITY
+#define NDN_ENCODING_BLOCK_ELEMENTS_CAPACITY 8
+#endif // NDN_ENCODING_BLOCK_ELEMENTS_CAPACITY
+
 namespace boost {
 namespace asio {
 class const_buffer;
@@ -38,7 +51,23 @@ class const_buffer;
 
 namespace ndn {
 
+class BlockPath;
+
 /** @brief Class representing a wire element of NDN-TLV packet format
+ *
+ *  Boundaries are stored as 32-bit offsets, so a Block must lie within the first 4 GiB
+ *  of its underlying buffer; creating or encoding a Block beyond that throws Block::Error.
+ *
+ *  Const methods, including parse() and the subelement accessors, can be called concurrently
+ *  from several threads on the same Block.  Non-const methods need exclusive access.
+ *
+ *  Modifying the subelements of a parsed Block that has wire encoding with push_back(),
+ *  insertElement(), eraseElement(), eraseElements(), remove() or patch() splices a new wire
+ *  encoding: the unchanged subelements are copied with one copy per contiguous range and
+ *  keep referring to the new buffer, so hasWire() stays true.  Enclosing Blocks are separate
+ *  objects and are not updated.  Otherwise, and from insert() or erase(), which return
+ *  an iterator through which subelements may change, until the next encode(), the Block is
+ *  reset and encoded by encode().
  */
 class Block
 {
@@ -57,11 +86,33 @@ public:
     }
   };
 
+  /** @brief Initial capacity of subelement storage
+   *  @sa NDN_ENCODING_BLOCK_ELEMENTS_CAPACITY
+   */
+  static const size_t ELEMENTS_CAPACITY = NDN_ENCODING_BLOCK_ELEMENTS_CAPACITY;
+
+  /** @brief Minimum number of subelements for which an index by type is kept
+   *  @sa find(uint32_t, size_t) const
+   */
+  static const size_t TYPE_INDEX_MIN_ELEMENTS = 16;
+
 public: // constructor, creation, assignment
   /** @brief Create an empty Block
    */
   Block();
 
+  Block(const Block& other);
+
+  Block(Block&& other) noexcept;
+
+  ~Block();
+
+  Block&
+  operator=(const Block& other);
+
+  Block&
+  operator=(Block&& other) noexcept;
+
   /** @brief Create a Block based on EncodingBuffer object
    */
   explicit
@@ -147,6 +198,35 @@ public: // constructor, creation, assignment
   static std::tuple<bool, Block>
   fromBuffer(ConstBufferPtr buffer, size_t offset);
 
+  /** @brief Try to construct block from the whole Buffer
+   *  @param buffer the buffer to construct block from; it must contain exactly one TLV
+   *
+   *  This is the non-throwing equivalent of Block(const ConstBufferPtr&).
+   *  This method does not copy the bytes.
+   *
+   *  @return true and the Block, if Block is successfully created; otherwise false
+   */
+  static std::tuple<bool, Block>
+  fromBuffer(ConstBufferPtr buffer);
+
+  /** @brief Try to construct block from a range of Buffer
+   *  @param buffer the buffer to construct block from
+   *  @param begin begin of the block within \p buffer
+   *  @param end end of the block within \p buffer
+   *  @param verifyLength if true, TLV-LENGTH must match the range exactly; otherwise
+   *                      TLV-LENGTH must not exceed the range
+   *
+   *  This is the non-throwing equivalent of Block(const ConstBufferPtr&, begin, end, verifyLength)
+   *  and, through Block::getBuffer(), of Block(const Block&, begin, end, verifyLength).
+   *  This method does not copy the bytes.
+   *
+   *  @return true and the Block, if Block is successfully created; otherwise false
+   */
+  static std::tuple<bool, Block>
+  fromBuffer(ConstBufferPtr buffer,
+             const Buffer::const_iterator& begin, const Buffer::const_iterator& end,
+             bool verifyLength = true);
+
   /** @brief Try to construct block from raw buffer
    *  @param buffer the raw buffer to copy bytes from
    *  @param maxSize the maximum size of constructed block;
@@ -190,6 +270,15 @@ public: // wire format
   const uint8_t*
   wire() const;
 
+  /** @brief Get the size of the encoded Block
+   *
+   *  A Block without wire encoding maintains the size it will have once encoded, so this
+   *  never encodes and takes constant time.  After insert() or erase() has returned an
+   *  iterator, through which a subelement can change, and until encode(), the size is
+   *  computed from the subelements instead.
+   *
+   *  @throw Error the Block is empty
+   */
   size_t
   size() const;
 
@@ -219,37 +308,122 @@ public: // sub elements
    *
    *  This method is not really const, but it does not modify any data.  It simply
    *  parses contents of the buffer into subblocks
+   *
+   *  Parsing only records the type and position of each subblock in a flat index.
+   *  The subblocks themselves are created on first access through elements(), find(),
+   *  get() or any of the modifiers.
+   *
+   *  Concurrent callers may each scan the value, but only one index is published; once
+   *  published, parse() and the subelement accessors do not lock.
    */
   void
   parse() const;
 
+  /** @brief Parse wire buffer into subblocks without throwing
+   *
+   *  This is the non-throwing equivalent of parse().  If the value is malformed,
+   *  no subblocks are kept.
+   *
+   *  @return true if the value is successfully parsed, false otherwise
+   */
+  bool
+  tryParse() const;
+
   /** @brief Encode subblocks into wire buffer
+   *
+   *  Sub elements that are not encoded themselves are encoded recursively, in the same
+   *  buffer.  The buffer is allocated once, and afterwards all sub elements refer to it.
    */
   void
   encode();
 
   /** @brief Get the first subelement of the requested type
+   *  @throw Error no subelement of the requested type exists
+   *  @sa find() for a non-throwing lookup
    */
   const Block&
   get(uint32_t type) const;
 
+  /** @brief Find the first subelement of the requested type
+   *  @return iterator to the subelement, or elements_end() if it does not exist
+   *
+   *  This method never throws.
+   *  @sa find(uint32_t, size_t) const for complexity
+   */
   element_const_iterator
   find(uint32_t type) const;
 
+  /** @brief Find a subelement of the requested type by its position among those of that type
+   *  @param type TLV-TYPE of the subelement
+   *  @param index zero-based position among subelements of @p type
+   *  @return iterator to the subelement, or elements_end() if it does not exist
+   *
+   *  Blocks with at least TYPE_INDEX_MIN_ELEMENTS subelements keep an index of subelements by
+   *  type, which answers in logarithmic time, or in constant time if no subelement has a
+   *  @p type below 256.  The index is built by parse() and by encode(); after a modification
+   *  and until the next encode(), lookups scan the subelements.
+   *
+   *  This method never throws.
+   */
+  element_const_iterator
+  find(uint32_t type, size_t index) const;
+
+  /** @brief Find the first subelement of the requested type by scanning the wire encoding
+   *
+   *  Headers are read only up to the first subelement of @p type, and no subelements are
+   *  created, so this is cheapest when the requested subelement comes first, such as the
+   *  Name of an Interest or Data.  A Block without wire encoding is searched with find().
+   *
+   *  This method never throws.
+   *
+   *  @return true and the subelement, sharing the buffer of this Block, if it is found;
+   *          false if it does not exist or a preceding subelement is malformed
+   */
+  std::tuple<bool, Block>
+  findInWire(uint32_t type) const;
+
+  /** @brief Count subelements of the requested type
+   *  @sa find(uint32_t, size_t) const for complexity
+   */
+  size_t
+  count(uint32_t type) const;
+
   /**
    * @brief remove all subelements of \p type
    * @param type TLV-TYPE of subelements to remove
    * @pre parse() has been invoked
+   *
+   * If the Block has no subelement of \p type, it is not modified.
    */
   void
   remove(uint32_t type);
 
+  /** @brief Erase the subelement at @p position
+   *
+   *  The returned iterator allows modifying subelements, which a spliced wire encoding
+   *  would not reflect, so the Block is reset until encode().
+   *  @sa eraseElement to keep the wire encoding
+   */
   element_iterator
   erase(element_const_iterator position);
 
+  /** @brief Erase the subelements in [@p first, @p last)
+   *  @sa erase(element_const_iterator), eraseElements
+   */
   element_iterator
   erase(element_const_iterator first, element_const_iterator last);
 
+  /** @brief Erase the subelement at @p position, splicing the wire encoding like push_back()
+   */
+  void
+  eraseElement(element_const_iterator position);
+
+  /** @brief Erase the subelements in [@p first, @p last), splicing the wire encoding
+   *         like push_back()
+   */
+  void
+  eraseElements(element_const_iterator first, element_const_iterator last);
+
   void
   push_back(const Block& element);
 
@@ -258,11 +432,49 @@ public: // sub elements
    * @param pos Position to insert the new element
    * @param element Element to be inserted
    * @return An iterator that points to the first of the newly inserted elements.
+   *
+   * The returned iterator allows modifying subelements, which a spliced wire encoding
+   * would not reflect, so the Block is reset until encode().
+   * @sa insertElement to keep the wire encoding
    */
   element_iterator
   insert(element_const_iterator pos, const Block& element);
 
+  /** @brief Insert @p element before @p pos, splicing the wire encoding like push_back()
+   *
+   *  This is the way to add a field at a position of a Block that has wire encoding,
+   *  e.g., a Selector of an Interest, without encoding it again.
+   */
+  void
+  insertElement(element_const_iterator pos, const Block& element);
+
+  /** @brief Replace the value of the nested element selected by @p path
+   *
+   *  If the new value has the size of the old one, as is usual for a Nonce or a lifetime,
+   *  it is written over the old one in the wire encoding.  If the buffer is shared with other
+   *  Blocks, this Block first copies its wire encoding, once, so that later patches are also
+   *  done in place:
+   *  @code
+   *  static const BlockPath nonce{tlv::Nonce};
+   *  interest.patch(nonce, newNonce, 4);
+   *  @endcode
+   *
+   *  Otherwise, the element is replaced by modifying its enclosing Blocks, which splices
+   *  the wire encoding.  In both cases, iterators to subelements are invalidated.
+   *
+   *  Whether the buffer is shared is decided from the owners of the buffer, i.e., Blocks and
+   *  the pointers returned by getBuffer().  BlockViews and pointers such as wire() or value()
+   *  into the wire encoding of this Block do not own it, so an in-place patch changes what
+   *  they refer to.  A reader that needs the old value must hold a copy of the Block.
+   *
+   *  @throw Error the selected element does not exist
+   */
+  void
+  patch(const BlockPath& path, const uint8_t* value, size_t valueSize);
+
   /** @brief Get all subelements
+   *
+   *  If the Block has been parsed, this creates the subelements from the index.
    */
   const element_container&
   elements() const;
@@ -273,6 +485,10 @@ public: // sub elements
   element_const_iterator
   elements_end() const;
 
+  /** @brief Get the number of subelements
+   *
+   *  This does not create the subelements of a parsed Block.
+   */
   size_t
   elements_size() const;
 
@@ -295,19 +511,157 @@ public: // EqualityComparable concept
 public: // ConvertibleToConstBuffer
   operator boost::asio::const_buffer() const;
 
-protected:
-  shared_ptr<const Buffer> m_buffer;
+private:
+  /** @brief Subelements of a Block, allocated only when the Block has any
+   */
+  struct Elements
+  {
+    /** @brief Subelements; created from index by materializeElements() if index is non-empty
+     */
+    element_container blocks;
+
+    /** @brief Headers of subelements recorded by parse()
+     *
+     *  The index is not modified while it is shared by concurrent readers.  Modifiers
+     *  clear it after creating the subelements, so an empty index means that blocks
+     *  is authoritative.
+     */
+    std::vector<tlv::ElementHeader> index;
+
+    /** @brief (type, position) of every subelement, sorted; valid only if hasTypeIndex
+     *
+     *  Like index, this is not modified while shared by concurrent readers.
+     */
+    std::vector<std::pair<uint32_t, uint32_t>> typeIndex;
+
+    /** @brief Presence of subelements of types below 256; valid only if hasTypeIndex
+     */
+    std::bitset<256> smallTypes;
+
+    bool hasTypeIndex = false;
+
+    /** @brief Value size of a Block without wire encoding, maintained by modifiers
+     */
+    size_t valueSize = 0;
+
+    /** @brief Whether insert() or erase() has returned an iterator through which subelements
+     *         may be modified since the last encoding; the maintained sizes are then not used
+     */
+    bool hasMutableIterators = false;
+
+    std::once_flag materializeOnce;
+  };
 
-  uint32_t m_type;
+  /** @brief Build the index by type of @p elements from subelements or headers @p container
+   */
+  template<class Container>
+  static void
+  indexTypes(Elements& elements, const Container& container);
 
-  Buffer::const_iterator m_begin;
-  Buffer::const_iterator m_end;
-  uint32_t m_size;
+  /** @brief Copy subelement storage; a parsed index is copied without the created subelements
+   */
+  static Elements*
+  copyElements(const Elements* elements);
 
-  Buffer::const_iterator m_value_begin;
-  Buffer::const_iterator m_value_end;
+  /** @brief Set wire and value boundaries within m_buffer
+   */
+  void
+  setRange(const Buffer::const_iterator& begin, const Buffer::const_iterator& end,
+           const Buffer::const_iterator& valueBegin, const Buffer::const_iterator& valueEnd);
+
+  /** @brief Encode this Block, and recursively its sub elements, right before @p end
+   *
+   *  Afterwards, this Block and its sub elements refer to @p buffer.
+   *
+   *  @return beginning of the encoding
+   */
+  uint8_t*
+  prependTo(const ConstBufferPtr& buffer, uint8_t* end);
+
+  /** @brief Replace the value of the element selected by @p path starting at @p step,
+   *         by modifying the subelements
+   */
+  void
+  patchElements(const BlockPath& path, size_t step, const uint8_t* value, size_t valueSize);
+
+  /** @brief Count the references to m_buffer held by this Block and its created subelements
+   */
+  long
+  countOwnReferences() const;
+
+  /** @brief Refer to a private copy of the wire encoding, without subelements sharing it
+   */
+  void
+  detachBuffer();
+
+  /** @brief Compute the size of the encoding, without the empty check of size()
+   */
+  size_t
+  encodedSize() const;
+
+  /** @brief Refer to a copy of the wire encoding at @p wire in @p buffer
+   */
+  void
+  rebase(const ConstBufferPtr& buffer, const uint8_t* wire);
 
-  mutable element_container m_subBlocks;
+  /** @brief Prepare a modification of the subelements
+   *  @return whether the wire encoding is to be spliced; otherwise the Block is reset
+   */
+  bool
+  prepareModification();
+
+  /** @brief Reset the Block before returning an iterator through which subelements may be
+   *         modified, and compute its size from the subelements until encode()
+   */
+  void
+  prepareMutableIterator();
+
+  /** @brief Splice the new wire encoding after a modification, or update the size of
+   *         a Block without wire encoding by @p sizeDelta
+   */
+  void
+  completeModification(bool isSplicing, ptrdiff_t sizeDelta);
+
+  /** @brief Rebuild wire encoding in a new buffer from the sub elements after a modification
+   *
+   *  Sub elements with wire encoding are copied, in runs that are adjacent in their source
+   *  buffer; the others are encoded in place.  Afterwards, all sub elements refer to
+   *  the new buffer.
+   */
+  void
+  spliceWire();
+
+  /** @brief Get subelement storage for modification, allocating it if necessary
+   */
+  element_container&
+  getSubBlocks();
+
+  /** @brief Create subelements from the index recorded by parse(), if not done yet
+   */
+  void
+  materializeElements() const;
+
+  /** @brief Reserve the initial capacity of subelement storage before the first insertion
+   */
+  void
+  reserveElements();
+
+protected:
+  // Fields used by type(), value() and size() come first, so that they share a cache line.
+  // Boundaries are 32-bit offsets from m_base, the start of m_buffer.
+  const uint8_t* m_base = nullptr;
+  uint32_t m_type = std::numeric_limits<uint32_t>::max();
+  uint32_t m_size = 0;
+  uint32_t m_begin = 0;
+  uint32_t m_end = 0;
+  uint32_t m_value_begin = 0;
+  uint32_t m_value_end = 0;
+
+  shared_ptr<const Buffer> m_buffer;
+
+  /** @brief Subelement storage, published atomically by parse()
+   */
+  mutable std::atomic<Elements*> m_elements{nullptr};
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -329,19 +683,43 @@ Block::type() const
 inline Buffer::const_iterator
 Block::value_begin() const
 {
-  return m_value_begin;
+  if (!hasValue())
+    return Buffer::const_iterator();
+
+  return m_buffer->begin() + m_value_begin;
 }
 
 inline Buffer::const_iterator
 Block::value_end() const
 {
-  return m_value_end;
+  if (!hasValue())
+    return Buffer::const_iterator();
+
+  return m_buffer->begin() + m_value_end;
 }
 
-inline const Block::element_container&
-Block::elements() const
+inline bool
+Block::hasValue() const
 {
-  return m_subBlocks;
+  return static_cast<bool>(m_buffer);
+}
+
+inline const uint8_t*
+Block::value() const
+{
+  if (!hasValue())
+    return 0;
+
+  return m_base + m_value_begin;
+}
+
+inline size_t
+Block::value_size() const
+{
+  if (!hasValue())
+    return 0;
+
+  return m_value_end - m_value_begin;
 }
 
 } // namespace ndn
@@ -25,6 +25,8 @@
 
 namespace ndn {
 
+const size_t Buffer::TAIL_PADDING;
+
 #if NDN_CXX_HAVE_IS_NOTHROW_MOVE_CONSTRUCTIBLE
 static_assert(std::is_nothrow_move_constructible<Buffer>::value,
               "Buffer must be MoveConstructible with noexcept");
@@ -44,10 +46,23 @@ Buffer::Buffer(size_t size)
 {
 }
 
+Buffer::Buffer(size_t size, TailPaddingTag)
+  : std::vector<uint8_t>(size + TAIL_PADDING, 0)
+{
+}
+
 Buffer::Buffer(const void* buf, size_t length)
   : std::vector<uint8_t>(reinterpret_cast<const uint8_t*>(buf),
                          reinterpret_cast<const uint8_t*>(buf) + length)
 {
 }
 
+Buffer::Buffer(const void* buf, size_t length, TailPaddingTag)
+  : std::vector<uint8_t>(length + TAIL_PADDING, 0)
+{
+  std::copy(reinterpret_cast<const uint8_t*>(buf),
+            reinterpret_cast<const uint8_t*>(buf) + length,
+            begin());
+}
+
 } // namespace ndn
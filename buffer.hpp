@@ -43,6 +43,27 @@ typedef shared_ptr<Buffer> BufferPtr;
  */
 class Buffer : public std::vector<uint8_t>
 {
+public:
+  /** @brief Number of zero octets appended by the tail-padding constructors
+   *
+   *  Padding is opt-in: Blocks and encoders create buffers of the exact encoding size.
+   *  A caller that receives packets into its own padded buffers, and builds Blocks over
+   *  the encoding with Block(const ConstBufferPtr&, begin, end), lets decoders load full
+   *  words near the end of the encoding without a bounds check for every field.
+   *
+   *  The padding is part of the buffer, i.e., it lies within [begin(), end()), but not part
+   *  of the encoding stored in it.
+   *
+   *  @sa isReadable
+   */
+  static const size_t TAIL_PADDING = 16;
+
+  /** @brief Tag type selecting the constructors that allocate tail padding
+   */
+  struct TailPaddingTag
+  {
+  };
+
 public:
   /** @brief Creates an empty buffer
    */
@@ -54,12 +75,26 @@ public:
   explicit
   Buffer(size_t size);
 
+  /** @brief Creates a buffer of @p size octets, followed by TAIL_PADDING zero octets
+   *  @param size size of the contents, excluding the padding
+   *  @post size() == @p size + TAIL_PADDING
+   */
+  Buffer(size_t size, TailPaddingTag);
+
   /** @brief Create a buffer by copying contents from a buffer
    *  @param buf const pointer to buffer
    *  @param length length of the buffer to copy
    */
   Buffer(const void* buf, size_t length);
 
+  /** @brief Create a buffer by copying contents from a buffer, followed by TAIL_PADDING
+   *         zero octets
+   *  @param buf const pointer to buffer
+   *  @param length length of the buffer to copy
+   *  @post size() == @p length + TAIL_PADDING
+   */
+  Buffer(const void* buf, size_t length, TailPaddingTag);
+
   /** @brief Create a buffer by copying contents of the range [first, last)
    *  @tparam InputIterator an InputIterator compatible with std::vector<uint8_t> constructor
    *  @param first iterator to the first element to copy
@@ -126,6 +161,15 @@ public:
   {
     return reinterpret_cast<const T*>(&front());
   }
+
+  /** @return true if the @p nOctets octets starting at @p first lie within the buffer
+   *  @pre @p first points into the buffer
+   */
+  bool
+  isReadable(const uint8_t* first, size_t nOctets) const
+  {
+    return static_cast<size_t>(data() + size() - first) >= nOctets;
+  }
 };
 
 } // namespace ndn
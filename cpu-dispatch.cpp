@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "cpu-dispatch.hpp"
+
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NDN_ENCODING_HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace ndn {
+namespace encoding {
+
+std::ostream&
+operator<<(std::ostream& os, SimdLevel level)
+{
+  switch (level) {
+  case SimdLevel::SCALAR:
+    return os << "scalar";
+  case SimdLevel::SSE42:
+    return os << "sse4.2";
+  case SimdLevel::AVX2:
+    return os << "avx2";
+  case SimdLevel::AVX512:
+    return os << "avx512";
+  }
+  return os << static_cast<int>(level);
+}
+
+static bool
+equalScalar(const uint8_t* first1, const uint8_t* first2, size_t length)
+{
+  // an empty range may be given as null pointers, which memcmp does not accept
+  return length == 0 || std::memcmp(first1, first2, length) == 0;
+}
+
+#ifdef NDN_ENCODING_HAVE_X86_SIMD
+
+__attribute__((target("sse4.2")))
+static bool
+equalSse42(const uint8_t* first1, const uint8_t* first2, size_t length)
+{
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first1 + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first2 + i));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF)
+      return false;
+  }
+  return equalScalar(first1 + i, first2 + i, length - i);
+}
+
+__attribute__((target("avx2")))
+static bool
+equalAvx2(const uint8_t* first1, const uint8_t* first2, size_t length)
+{
+  size_t i = 0;
+  for (; i + 32 <= length; i += 32) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first1 + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first2 + i));
+    if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))) != 0xFFFFFFFF)
+      return false;
+  }
+  return equalScalar(first1 + i, first2 + i, length - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+static bool
+equalAvx512(const uint8_t* first1, const uint8_t* first2, size_t length)
+{
+  size_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    __m512i a = _mm512_loadu_si512(first1 + i);
+    __m512i b = _mm512_loadu_si512(first2 + i);
+    if (_mm512_cmpneq_epi8_mask(a, b) != 0)
+      return false;
+  }
+  return equalScalar(first1 + i, first2 + i, length - i);
+}
+
+#endif // NDN_ENCODING_HAVE_X86_SIMD
+
+static const SimdKernels KERNELS[] = {
+  {SimdLevel::SCALAR, &equalScalar},
+#ifdef NDN_ENCODING_HAVE_X86_SIMD
+  {SimdLevel::SSE42,  &equalSse42},
+  {SimdLevel::AVX2,   &equalAvx2},
+  {SimdLevel::AVX512, &equalAvx512},
+#endif // NDN_ENCODING_HAVE_X86_SIMD
+};
+
+SimdLevel
+detectSimdLevel()
+{
+#ifdef NDN_ENCODING_HAVE_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    return SimdLevel::AVX512;
+  if (__builtin_cpu_supports("avx2"))
+    return SimdLevel::AVX2;
+  if (__builtin_cpu_supports("sse4.2"))
+    return SimdLevel::SSE42;
+#endif // NDN_ENCODING_HAVE_X86_SIMD
+  return SimdLevel::SCALAR;
+}
+
+const SimdKernels&
+getSimdKernels(SimdLevel level)
+{
+  static const SimdLevel detected = detectSimdLevel();
+  if (level > detected)
+    level = detected;
+
+  return KERNELS[static_cast<size_t>(level)];
+}
+
+SimdLevel
+parseSimdLevel(const std::string& name)
+{
+  static const struct {
+    const char* name;
+    SimdLevel level;
+  } LEVEL_NAMES[] = {
+    {"scalar", SimdLevel::SCALAR},
+    {"sse4.2", SimdLevel::SSE42},
+    {"avx2",   SimdLevel::AVX2},
+    {"avx512", SimdLevel::AVX512},
+  };
+  for (const auto& entry : LEVEL_NAMES) {
+    if (name == entry.name)
+      return entry.level;
+  }
+  BOOST_THROW_EXCEPTION(std::invalid_argument("Unknown SIMD level \"" + name + "\" "
+                                              "(expecting scalar, sse4.2, avx2, or avx512)"));
+}
+
+SimdLevel
+selectSimdLevel()
+{
+  SimdLevel level = detectSimdLevel();
+
+  const char* name = std::getenv("NDN_ENCODING_SIMD");
+  if (name == nullptr)
+    return level;
+
+  return std::min(parseSimdLevel(name), level);
+}
+
+const SimdKernels&
+getSimdKernels()
+{
+  static const SimdKernels& kernels = getSimdKernels(selectSimdLevel());
+  return kernels;
+}
+
+} // namespace encoding
+} // namespace ndn
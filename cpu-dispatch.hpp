@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_CPU_DISPATCH_HPP
+#define NDN_ENCODING_CPU_DISPATCH_HPP
+
+#include "../common.hpp"
+
+#include <iosfwd>
+#include <string>
+
+namespace ndn {
+namespace encoding {
+
+/** @brief SIMD instruction set level of encoding kernels
+ */
+enum class SimdLevel {
+  SCALAR = 0,
+  SSE42  = 1,
+  AVX2   = 2,
+  AVX512 = 3
+};
+
+std::ostream&
+operator<<(std::ostream& os, SimdLevel level);
+
+/** @brief Table of encoding kernels implemented for one SimdLevel
+ */
+struct SimdKernels
+{
+  SimdLevel level;
+
+  /** @brief Compare @p length octets starting at @p first1 and @p first2
+   *  @return true if the octets are equal
+   */
+  bool
+  (*equal)(const uint8_t* first1, const uint8_t* first2, size_t length);
+};
+
+/** @return the highest SimdLevel supported by the CPU
+ *
+ *  This is always SimdLevel::SCALAR on platforms other than x86.
+ */
+SimdLevel
+detectSimdLevel();
+
+/** @return kernels of @p level, lowered to detectSimdLevel() if the CPU does not support it
+ *
+ *  This allows tests to exercise every implementation the CPU supports.
+ */
+const SimdKernels&
+getSimdKernels(SimdLevel level);
+
+/** @return the SimdLevel named @p name: "scalar", "sse4.2", "avx2", or "avx512"
+ *  @throw std::invalid_argument @p name is not one of these
+ */
+SimdLevel
+parseSimdLevel(const std::string& name);
+
+/** @return detectSimdLevel(), lowered to the level named by environment variable
+ *          NDN_ENCODING_SIMD if it is set
+ *  @throw std::invalid_argument NDN_ENCODING_SIMD does not name a SimdLevel
+ */
+SimdLevel
+selectSimdLevel();
+
+/** @return kernels selected for this process
+ *
+ *  The kernels are selected once, on first successful use, at selectSimdLevel().
+ *
+ *  @throw std::invalid_argument NDN_ENCODING_SIMD does not name a SimdLevel
+ */
+const SimdKernels&
+getSimdKernels();
+
+} // namespace encoding
+} // namespace ndn
+
+#endif // NDN_ENCODING_CPU_DISPATCH_HPP
@@ -20,6 +20,7 @@
  */
 
 #include "encoder.hpp"
+#include "estimator.hpp"
 
 namespace ndn {
 namespace encoding {
@@ -145,96 +146,42 @@ Encoder::appendByteArray(const uint8_t* array, size_t length)
 size_t
 Encoder::prependVarNumber(uint64_t varNumber)
 {
-  if (varNumber < 253) {
-    prependByte(static_cast<uint8_t>(varNumber));
-    return 1;
-  }
-  else if (varNumber <= std::numeric_limits<uint16_t>::max()) {
-    uint16_t value = htobe16(static_cast<uint16_t>(varNumber));
-    prependByteArray(reinterpret_cast<const uint8_t*>(&value), 2);
-    prependByte(253);
-    return 3;
-  }
-  else if (varNumber <= std::numeric_limits<uint32_t>::max()) {
-    uint32_t value = htobe32(static_cast<uint32_t>(varNumber));
-    prependByteArray(reinterpret_cast<const uint8_t*>(&value), 4);
-    prependByte(254);
-    return 5;
-  }
-  else {
-    uint64_t value = htobe64(varNumber);
-    prependByteArray(reinterpret_cast<const uint8_t*>(&value), 8);
-    prependByte(255);
-    return 9;
-  }
+  size_t length = tlv::sizeOfVarNumber(varNumber);
+  reserveFront(length);
+
+  m_begin -= length;
+  return tlv::writeVarNumber(&*m_begin, varNumber);
 }
 
 size_t
 Encoder::appendVarNumber(uint64_t varNumber)
 {
-  if (varNumber < 253) {
-    appendByte(static_cast<uint8_t>(varNumber));
-    return 1;
-  }
-  else if (varNumber <= std::numeric_limits<uint16_t>::max()) {
-    appendByte(253);
-    uint16_t value = htobe16(static_cast<uint16_t>(varNumber));
-    appendByteArray(reinterpret_cast<const uint8_t*>(&value), 2);
-    return 3;
-  }
-  else if (varNumber <= std::numeric_limits<uint32_t>::max()) {
-    appendByte(254);
-    uint32_t value = htobe32(static_cast<uint32_t>(varNumber));
-    appendByteArray(reinterpret_cast<const uint8_t*>(&value), 4);
-    return 5;
-  }
-  else {
-    appendByte(255);
-    uint64_t value = htobe64(varNumber);
-    appendByteArray(reinterpret_cast<const uint8_t*>(&value), 8);
-    return 9;
-  }
+  reserveBack(9);
+
+  size_t length = tlv::writeVarNumber(&*m_end, varNumber);
+  m_end += length;
+  return length;
 }
 
 
 size_t
 Encoder::prependNonNegativeInteger(uint64_t varNumber)
 {
-  if (varNumber <= std::numeric_limits<uint8_t>::max()) {
-    return prependByte(static_cast<uint8_t>(varNumber));
-  }
-  else if (varNumber <= std::numeric_limits<uint16_t>::max()) {
-    uint16_t value = htobe16(static_cast<uint16_t>(varNumber));
-    return prependByteArray(reinterpret_cast<const uint8_t*>(&value), 2);
-  }
-  else if (varNumber <= std::numeric_limits<uint32_t>::max()) {
-    uint32_t value = htobe32(static_cast<uint32_t>(varNumber));
-    return prependByteArray(reinterpret_cast<const uint8_t*>(&value), 4);
-  }
-  else {
-    uint64_t value = htobe64(varNumber);
-    return prependByteArray(reinterpret_cast<const uint8_t*>(&value), 8);
-  }
+  size_t length = tlv::sizeOfNonNegativeInteger(varNumber);
+  reserveFront(length);
+
+  m_begin -= length;
+  return tlv::writeNonNegativeInteger(&*m_begin, varNumber);
 }
 
 size_t
 Encoder::appendNonNegativeInteger(uint64_t varNumber)
 {
-  if (varNumber <= std::numeric_limits<uint8_t>::max()) {
-    return appendByte(static_cast<uint8_t>(varNumber));
-  }
-  else if (varNumber <= std::numeric_limits<uint16_t>::max()) {
-    uint16_t value = htobe16(static_cast<uint16_t>(varNumber));
-    return appendByteArray(reinterpret_cast<const uint8_t*>(&value), 2);
-  }
-  else if (varNumber <= std::numeric_limits<uint32_t>::max()) {
-    uint32_t value = htobe32(static_cast<uint32_t>(varNumber));
-    return appendByteArray(reinterpret_cast<const uint8_t*>(&value), 4);
-  }
-  else {
-    uint64_t value = htobe64(varNumber);
-    return appendByteArray(reinterpret_cast<const uint8_t*>(&value), 8);
-  }
+  reserveBack(8);
+
+  size_t length = tlv::writeNonNegativeInteger(&*m_end, varNumber);
+  m_end += length;
+  return length;
 }
 
 size_t
@@ -257,6 +204,37 @@ Encoder::appendByteArrayBlock(uint32_t type, const uint8_t* array, size_t arrayS
   return totalLength;
 }
 
+size_t
+Encoder::prependNonNegativeIntegerBlocks(const std::pair<uint32_t, uint64_t>* fields,
+                                         size_t nFields)
+{
+  size_t totalLength = Estimator().prependNonNegativeIntegerBlocks(fields, nFields);
+  reserveFront(totalLength);
+
+  m_begin -= totalLength;
+  uint8_t* pos = &*m_begin;
+  uint8_t* end = pos + totalLength;
+  for (size_t i = 0; i < nFields; ++i) {
+    pos += tlv::writeVarNumber(pos, fields[i].first);
+
+    uint64_t value = fields[i].second;
+    size_t valueLength = tlv::sizeOfNonNegativeInteger(value);
+    *pos++ = static_cast<uint8_t>(valueLength);
+
+    if (end - pos >= 8) {
+      // a full-width store, whose excess octets are overwritten by the next field
+      uint64_t bigEndian = htobe64(value << (64 - 8 * valueLength));
+      std::memcpy(pos, &bigEndian, 8);
+    }
+    else {
+      tlv::writeNonNegativeInteger(pos, value);
+    }
+    pos += valueLength;
+  }
+
+  return totalLength;
+}
+
 size_t
 Encoder::prependBlock(const Block& block)
 {
@@ -118,6 +118,21 @@ Estimator::appendByteArrayBlock(uint32_t type, const uint8_t* array, size_t arra
 }
 
 
+size_t
+Estimator::prependNonNegativeIntegerBlocks(const std::pair<uint32_t, uint64_t>* fields,
+                                           size_t nFields)
+{
+  // TLV-LENGTH of a nonNegativeInteger is always a single octet
+  size_t totalLength = nFields;
+  for (size_t i = 0; i < nFields; ++i) {
+    totalLength += tlv::sizeOfVarNumber(fields[i].first) +
+                   tlv::sizeOfNonNegativeInteger(fields[i].second);
+  }
+
+  return totalLength;
+}
+
+
 size_t
 Estimator::prependBlock(const Block& block)
 {
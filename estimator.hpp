@@ -121,6 +121,16 @@ public: // common interface between Encoder and Estimator
   size_t
   prependByteArrayBlock(uint32_t type, const uint8_t* array, size_t arraySize);
 
+  /**
+   * @brief Prepend @p nFields TLV blocks containing non-negative integers
+   * @param fields array of (TLV-TYPE, value) pairs, encoded in the same order
+   *
+   * The result is the same as calling prependNonNegativeIntegerBlock for every field in
+   * reverse order, but all blocks are written in one pass.
+   */
+  size_t
+  prependNonNegativeIntegerBlocks(const std::pair<uint32_t, uint64_t>* fields, size_t nFields);
+
   /**
    * @brief Append TLV block of type @p type and value from buffer @p array of size @p arraySize
    */
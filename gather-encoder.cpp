@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "gather-encoder.hpp"
+
+namespace ndn {
+namespace encoding {
+
+const size_t GatherEncoder::DEFAULT_REFERENCE_THRESHOLD;
+
+GatherEncoder::GatherEncoder(size_t referenceThreshold)
+  : m_referenceThreshold(referenceThreshold)
+  , m_size(0)
+{
+}
+
+size_t
+GatherEncoder::appendBlock(const Block& block)
+{
+  size_t size = block.size();
+
+  if (block.hasWire()) {
+    if (size >= m_referenceThreshold)
+      appendReference(block.getBuffer(), block.wire(), size);
+    else
+      appendCopy(block.wire(), size);
+    return size;
+  }
+
+  appendVarNumber(block.type());
+
+  if (block.hasValue()) {
+    appendVarNumber(block.value_size());
+    if (block.value_size() >= m_referenceThreshold)
+      appendReference(block.getBuffer(), block.value(), block.value_size());
+    else
+      appendCopy(block.value(), block.value_size());
+    return size;
+  }
+
+  size_t valueSize = 0;
+  for (const Block& element : block.elements()) {
+    valueSize += element.size();
+  }
+  appendVarNumber(valueSize);
+
+  for (const Block& element : block.elements()) {
+    appendBlock(element);
+  }
+  return size;
+}
+
+std::vector<boost::asio::const_buffer>
+GatherEncoder::buffers() const
+{
+  std::vector<boost::asio::const_buffer> buffers;
+  buffers.reserve(m_segments.size());
+  for (const Segment& segment : m_segments) {
+    const uint8_t* data = segment.data != nullptr ? segment.data : m_copies.data() + segment.offset;
+    buffers.push_back(boost::asio::const_buffer(data, segment.size));
+  }
+  return buffers;
+}
+
+void
+GatherEncoder::clear()
+{
+  m_copies.clear();
+  m_segments.clear();
+  m_references.clear();
+  m_size = 0;
+}
+
+void
+GatherEncoder::appendVarNumber(uint64_t varNumber)
+{
+  uint8_t buffer[9];
+  appendCopy(buffer, tlv::writeVarNumber(buffer, varNumber));
+}
+
+void
+GatherEncoder::appendCopy(const uint8_t* data, size_t size)
+{
+  // consecutive copies form one segment; segments hold offsets, as m_copies may reallocate
+  if (m_segments.empty() || m_segments.back().data != nullptr)
+    m_segments.push_back(Segment{nullptr, m_copies.size(), 0});
+
+  m_copies.insert(m_copies.end(), data, data + size);
+  m_segments.back().size += size;
+  m_size += size;
+}
+
+void
+GatherEncoder::appendReference(const ConstBufferPtr& buffer, const uint8_t* data, size_t size)
+{
+  m_references.push_back(buffer);
+  m_segments.push_back(Segment{data, 0, size});
+  m_size += size;
+}
+
+} // namespace encoding
+} // namespace ndn
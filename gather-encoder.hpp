@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_GATHER_ENCODER_HPP
+#define NDN_ENCODING_GATHER_ENCODER_HPP
+
+#include "../common.hpp"
+#include "block.hpp"
+
+#include <boost/asio/buffer.hpp>
+
+namespace ndn {
+namespace encoding {
+
+/** @brief Encoder producing the wire encoding of Blocks as a sequence of buffers
+ *
+ *  Large values are referenced instead of copied: wire encodings and values of at least
+ *  the reference threshold are added as separate buffers, sharing ownership of their Block's
+ *  underlying buffer.  Headers of Blocks without wire encoding and small elements are copied
+ *  into one internal buffer.  The result is a ConstBufferSequence, which can be passed to
+ *  a gathering write such as boost::asio::write() on a socket:
+ *  @code
+ *  GatherEncoder encoder;
+ *  encoder.appendBlock(data);
+ *  boost::asio::write(socket, encoder.buffers());
+ *  @endcode
+ *
+ *  Blocks are never encoded: the headers of a Block without wire encoding are written from
+ *  its size and the sizes of its subelements.
+ *
+ *  wireEncode() of a packet prepends every field into one EncodingBuffer, which copies the
+ *  Content.  A producer serving large content instead builds the packet as a Block without
+ *  wire encoding, whose Content refers to the payload buffer, and appends that Block:
+ *  @code
+ *  Block packet(tlv::Data);
+ *  packet.push_back(name.wireEncode());
+ *  packet.push_back(metaInfo.wireEncode());
+ *  packet.push_back(Block(tlv::Content, payload)); // payload is a ConstBufferPtr, not copied
+ *  packet.push_back(signatureInfo);
+ *  packet.push_back(signatureValue);
+ *
+ *  GatherEncoder encoder;
+ *  encoder.appendBlock(packet);
+ *  boost::asio::write(socket, encoder.buffers());
+ *  @endcode
+ *  The signature is computed over the same fields, e.g., by feeding the buffers of
+ *  a GatherEncoder holding Name, MetaInfo, Content, and SignatureInfo to the digest.
+ *  The payload buffer must not be modified until the write completes.
+ */
+class GatherEncoder
+{
+public:
+  /** @brief Default size from which wire encodings and values are referenced
+   */
+  static const size_t DEFAULT_REFERENCE_THRESHOLD = 1024;
+
+  explicit
+  GatherEncoder(size_t referenceThreshold = DEFAULT_REFERENCE_THRESHOLD);
+
+  GatherEncoder(const GatherEncoder&) = delete;
+
+  GatherEncoder&
+  operator=(const GatherEncoder&) = delete;
+
+  /** @brief Append the wire encoding of @p block
+   *  @return number of bytes appended
+   *  @throw Block::Error @p block is empty
+   */
+  size_t
+  appendBlock(const Block& block);
+
+  /** @brief Get the appended wire encodings as a sequence of buffers
+   *
+   *  The buffers are valid until the encoder is modified or destroyed.
+   */
+  std::vector<boost::asio::const_buffer>
+  buffers() const;
+
+  /** @brief Get the total number of bytes appended
+   */
+  size_t
+  size() const;
+
+  /** @brief Remove all appended wire encodings
+   */
+  void
+  clear();
+
+private:
+  void
+  appendVarNumber(uint64_t varNumber);
+
+  void
+  appendCopy(const uint8_t* data, size_t size);
+
+  void
+  appendReference(const ConstBufferPtr& buffer, const uint8_t* data, size_t size);
+
+private:
+  /** @brief Part of the output, either a referenced range or a range of m_copies
+   */
+  struct Segment
+  {
+    const uint8_t* data; ///< nullptr for a range of m_copies
+    size_t offset;       ///< offset in m_copies
+    size_t size;
+  };
+
+  size_t m_referenceThreshold;
+  std::vector<uint8_t> m_copies;
+  std::vector<Segment> m_segments;
+  std::vector<ConstBufferPtr> m_references;
+  size_t m_size;
+};
+
+inline size_t
+GatherEncoder::size() const
+{
+  return m_size;
+}
+
+} // namespace encoding
+} // namespace ndn
+
+#endif // NDN_ENCODING_GATHER_ENCODER_HPP
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "../block.hpp"
+#include "../block-helpers.hpp"
+#include "../encoding-buffer.hpp"
+
+#include "boost-test.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestBlockConcurrency)
+
+static const size_t N_ELEMENTS = 40;
+static const size_t N_THREADS = 4;
+static const size_t N_ROUNDS = 200;
+
+/** @brief Create an element with N_ELEMENTS NonNegativeInteger subelements of alternating type,
+ *         enough for the index by type
+ *
+ *  Elements are prepended, so the values decrease from N_ELEMENTS - 1, of TLV-TYPE 300.
+ */
+static Block
+makeWire()
+{
+  EncodingBuffer encoder;
+  for (size_t i = 0; i < N_ELEMENTS; ++i) {
+    prependNonNegativeIntegerBlock(encoder, i % 2 ? 300 : 128, i);
+  }
+  encoder.prependVarNumber(encoder.size());
+  encoder.prependVarNumber(100);
+  return Block(encoder);
+}
+
+static bool
+readConcurrently(const Block& block)
+{
+  block.parse();
+
+  Block copy = block;
+  copy.parse();
+
+  return block.elements_size() == N_ELEMENTS &&
+         block.count(128) == N_ELEMENTS / 2 &&
+         block.count(300) == N_ELEMENTS / 2 &&
+         readNonNegativeInteger(*block.find(128, 3)) == 32 &&
+         readNonNegativeInteger(*block.find(300, 0)) == 39 &&
+         block.find(5) == block.elements_end() &&
+         readNonNegativeInteger(block.get(300)) == 39 &&
+         readNonNegativeInteger(copy.get(128)) == 38 &&
+         copy.elements_size() == N_ELEMENTS;
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentReaders)
+{
+  const Block wire = makeWire();
+
+  for (size_t round = 0; round < N_ROUNDS; ++round) {
+    // every round races on a Block that is neither parsed nor materialized
+    const Block block(wire.wire(), wire.size());
+
+    std::vector<char> isOk(N_THREADS, false);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < N_THREADS; ++i) {
+      threads.emplace_back([&block, &isOk, i] { isOk[i] = readConcurrently(block); });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    for (size_t i = 0; i < N_THREADS; ++i) {
+      BOOST_CHECK(isOk[i]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CopyAfterResetWire)
+{
+  const Block wire = makeWire();
+
+  Block block(wire.wire(), wire.size());
+  block.parse();
+  block.resetWire();
+  BOOST_CHECK(!block.hasWire());
+
+  Block copy = block;
+  BOOST_CHECK_EQUAL(copy.elements_size(), N_ELEMENTS);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(*copy.find(300, 2)), 35);
+
+  copy.encode();
+  BOOST_CHECK_EQUAL_COLLECTIONS(copy.begin(), copy.end(), wire.begin(), wire.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBlockConcurrency
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../block-helpers.hpp"
+#include "../encoding-buffer.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace encoding {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestBlockHelpers)
+
+// values on both sides of every nonNegativeInteger and VAR-NUMBER width boundary;
+// TLV-TYPE 0xffffffff is avoided, as it marks an empty Block
+static const std::pair<uint32_t, uint64_t> FIELDS[] = {
+  {0x07, 0},
+  {0x08, 252},
+  {252, 253},
+  {253, 255},
+  {0x80, 256},
+  {0xffff, 65535},
+  {0x10000, 65536},
+  {0x81, 0xffffffff},
+  {0xfffffffe, 0x100000000},
+  {0x82, std::numeric_limits<uint64_t>::max()},
+};
+static const size_t N_FIELDS = sizeof(FIELDS) / sizeof(FIELDS[0]);
+
+BOOST_AUTO_TEST_CASE(PrependNonNegativeIntegerBlocks)
+{
+  EncodingBuffer expected;
+  EncodingEstimator estimator;
+  size_t estimatedLength = 0;
+  for (size_t i = N_FIELDS; i > 0; --i) {
+    prependNonNegativeIntegerBlock(expected, FIELDS[i - 1].first, FIELDS[i - 1].second);
+    estimatedLength += prependNonNegativeIntegerBlock(estimator,
+                                                      FIELDS[i - 1].first, FIELDS[i - 1].second);
+  }
+
+  EncodingBuffer encoder;
+  size_t length = encoder.prependNonNegativeIntegerBlocks(FIELDS, N_FIELDS);
+  BOOST_CHECK_EQUAL(length, encoder.size());
+  BOOST_CHECK_EQUAL(EncodingEstimator().prependNonNegativeIntegerBlocks(FIELDS, N_FIELDS),
+                    length);
+  BOOST_CHECK_EQUAL(estimatedLength, length);
+  BOOST_CHECK_EQUAL_COLLECTIONS(encoder.begin(), encoder.end(),
+                                expected.begin(), expected.end());
+
+  // each value has the minimal width
+  Buffer wire(encoder.buf(), encoder.size());
+  Buffer::const_iterator begin = wire.begin();
+  for (size_t i = 0; i < N_FIELDS; ++i) {
+    bool isOk = false;
+    Block element;
+    std::tie(isOk, element) = Block::fromBuffer(&*begin, wire.end() - begin);
+    BOOST_REQUIRE(isOk);
+    BOOST_CHECK_EQUAL(element.type(), FIELDS[i].first);
+    BOOST_CHECK_EQUAL(element.value_size(), tlv::sizeOfNonNegativeInteger(FIELDS[i].second));
+    BOOST_CHECK_EQUAL(readNonNegativeInteger(element), FIELDS[i].second);
+    begin += element.size();
+  }
+  BOOST_CHECK(begin == wire.end());
+}
+
+BOOST_AUTO_TEST_CASE(ReadNonNegativeIntegerBlocks)
+{
+  EncodingBuffer encoder;
+  encoder.prependNonNegativeIntegerBlocks(FIELDS, N_FIELDS);
+  encoder.appendByteArray(reinterpret_cast<const uint8_t*>("\x09\x00"), 2);
+  Buffer wire(encoder.buf(), encoder.size());
+
+  uint32_t types[N_FIELDS];
+  uint64_t values[N_FIELDS];
+  for (size_t i = 0; i < N_FIELDS; ++i)
+    types[i] = FIELDS[i].first;
+
+  Buffer::const_iterator begin = wire.begin();
+  readNonNegativeIntegerBlocks(begin, wire.end(), types, values, N_FIELDS);
+  for (size_t i = 0; i < N_FIELDS; ++i)
+    BOOST_CHECK_EQUAL(values[i], FIELDS[i].second);
+  // stops after the last requested block
+  BOOST_CHECK(begin == wire.end() - 2);
+
+  // unexpected type
+  types[3] = 254;
+  begin = wire.begin();
+  BOOST_CHECK_THROW(readNonNegativeIntegerBlocks(begin, wire.end(), types, values, N_FIELDS),
+                    tlv::Error);
+
+  // truncated
+  types[3] = FIELDS[3].first;
+  begin = wire.begin();
+  BOOST_CHECK_THROW(readNonNegativeIntegerBlocks(begin, wire.end() - 3, types, values, N_FIELDS),
+                    tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ReadNonNegativeIntegerBlocksMalformed)
+{
+  static const uint32_t TYPES[] = {0x07};
+  uint64_t value = 0;
+
+  // TLV-LENGTH 3 and 9 are not valid nonNegativeInteger widths
+  static const uint8_t LENGTH_3[] = {0x07, 0x03, 0x01, 0x02, 0x03};
+  Buffer length3(LENGTH_3, sizeof(LENGTH_3));
+  Buffer::const_iterator begin = length3.begin();
+  BOOST_CHECK_THROW(readNonNegativeIntegerBlocks(begin, length3.end(), TYPES, &value, 1),
+                    tlv::Error);
+
+  static const uint8_t LENGTH_9[] = {0x07, 0x09, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+                                     0x09};
+  Buffer length9(LENGTH_9, sizeof(LENGTH_9));
+  begin = length9.begin();
+  BOOST_CHECK_THROW(readNonNegativeIntegerBlocks(begin, length9.end(), TYPES, &value, 1),
+                    tlv::Error);
+
+  Buffer empty;
+  begin = empty.begin();
+  BOOST_CHECK_THROW(readNonNegativeIntegerBlocks(begin, empty.end(), TYPES, &value, 1),
+                    tlv::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBlockHelpers
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace encoding
+} // namespace ndn
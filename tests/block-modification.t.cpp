@@ -0,0 +1,347 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "../block.hpp"
+#include "../block-helpers.hpp"
+#include "../block-path.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestBlockModification)
+
+BOOST_AUTO_TEST_CASE(MaintainedSize)
+{
+  Block block(100);
+  BOOST_CHECK_EQUAL(block.size(), 2);
+
+  std::vector<uint8_t> value(300, 0xAA);
+  for (size_t i = 0; i < 3; ++i) {
+    block.push_back(makeBinaryBlock(101, value.data(), value.size()));
+  }
+  BOOST_CHECK_EQUAL(block.size(), 1 + 3 + 3 * (1 + 3 + 300));
+
+  block.remove(101);
+  BOOST_CHECK_EQUAL(block.size(), 2);
+
+  block.push_back(makeNonNegativeIntegerBlock(102, 1));
+  block.encode();
+  BOOST_CHECK_EQUAL(block.size(), 5);
+  BOOST_CHECK_EQUAL(block.getBuffer()->size(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(ModifyThroughIterator)
+{
+  std::vector<uint8_t> value(300, 0xAA);
+
+  Block block(100);
+  Block::element_iterator it = block.insert(block.elements_end(), Block(101));
+  it->push_back(makeBinaryBlock(102, value.data(), value.size()));
+  BOOST_CHECK_EQUAL(block.size(), 1 + 3 + 1 + 3 + 1 + 3 + 300);
+
+  block.encode();
+  BOOST_CHECK_EQUAL(block.size(), 1 + 3 + 1 + 3 + 1 + 3 + 300);
+  BOOST_CHECK_EQUAL(block.value_size(), 1 + 3 + 1 + 3 + 300);
+
+  Block decoded(block.wire(), block.size());
+  decoded.parse();
+  BOOST_REQUIRE_EQUAL(decoded.elements_size(), 1);
+  BOOST_CHECK_EQUAL(decoded.elements().front().value_size(), 1 + 3 + 300);
+}
+
+BOOST_AUTO_TEST_CASE(SpliceParsed)
+{
+  static const uint8_t WIRE[] = {0x64, 0x06, 0x01, 0x01, 0x05, 0x01, 0x01, 0x05};
+  static const uint8_t EXPECTED[] = {0x64, 0x09, 0x01, 0x01, 0x05, 0x01, 0x01, 0x05,
+                                     0x02, 0x01, 0x07};
+  static const uint8_t REMOVED[] = {0x64, 0x03, 0x02, 0x01, 0x07};
+
+  Block block(WIRE, sizeof(WIRE));
+  block.parse();
+  block.push_back(makeNonNegativeIntegerBlock(2, 7));
+  BOOST_CHECK(block.hasWire());
+  BOOST_CHECK_EQUAL_COLLECTIONS(block.begin(), block.end(), EXPECTED, EXPECTED + sizeof(EXPECTED));
+
+  block.remove(1);
+  BOOST_CHECK(block.hasWire());
+  BOOST_CHECK_EQUAL_COLLECTIONS(block.begin(), block.end(), REMOVED, REMOVED + sizeof(REMOVED));
+}
+
+BOOST_AUTO_TEST_CASE(ResetUnparsed)
+{
+  static const uint8_t WIRE[] = {0x64, 0x06, 0x01, 0x01, 0x05, 0x01, 0x01, 0x05};
+  static const uint8_t EXPECTED[] = {0x64, 0x03, 0x02, 0x01, 0x07};
+
+  Block block(WIRE, sizeof(WIRE));
+  block.push_back(makeNonNegativeIntegerBlock(2, 7));
+  BOOST_CHECK(!block.hasWire());
+  BOOST_CHECK_EQUAL(block.size(), sizeof(EXPECTED));
+
+  block.encode();
+  BOOST_CHECK_EQUAL_COLLECTIONS(block.begin(), block.end(), EXPECTED, EXPECTED + sizeof(EXPECTED));
+}
+
+BOOST_AUTO_TEST_CASE(ModifyNested)
+{
+  std::vector<uint8_t> value(300, 0xAA);
+
+  // Block(100) { Block(101) { Block(102) { Binary(103) } }, NonNegativeInteger(104) }
+  Block block(100);
+  block.push_back(makeNonNegativeIntegerBlock(104, 1));
+  Block::element_iterator child = block.insert(block.elements_begin(), Block(101));
+  Block::element_iterator grandchild = child->insert(child->elements_end(), Block(102));
+  BOOST_CHECK_EQUAL(block.size(), 2 + 2 + 2 + 3);
+
+  // sizes of the ancestors follow modifications made through the iterators
+  grandchild->push_back(makeBinaryBlock(103, value.data(), value.size()));
+  BOOST_CHECK_EQUAL(grandchild->size(), 1 + 3 + 1 + 3 + 300);
+  BOOST_CHECK_EQUAL(block.elements()[0].size(), 1 + 3 + 1 + 3 + 1 + 3 + 300);
+  BOOST_CHECK_EQUAL(block.size(), 1 + 3 + 1 + 3 + 1 + 3 + 1 + 3 + 300 + 3);
+
+  size_t size = block.size();
+  block.encode();
+  BOOST_CHECK_EQUAL(block.size(), size);
+  BOOST_CHECK_EQUAL(block.getBuffer()->size(), size);
+
+  Block decoded(block.wire(), block.size());
+  decoded.parse();
+  BOOST_REQUIRE_EQUAL(decoded.elements_size(), 2);
+  Block decodedChild = decoded.elements()[0];
+  decodedChild.parse();
+  BOOST_REQUIRE_EQUAL(decodedChild.elements_size(), 1);
+  BOOST_CHECK_EQUAL(decodedChild.elements()[0].value_size(), 1 + 3 + 300);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(decoded.elements()[1]), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ResetAfterIterator)
+{
+  std::vector<uint8_t> value(300, 0xAA);
+
+  Block block(100);
+  block.encode();
+  Block::element_iterator it = block.insert(block.elements_end(), Block(101));
+  BOOST_CHECK(!block.hasWire());
+  it->push_back(makeBinaryBlock(102, value.data(), value.size()));
+
+  // the parent cannot splice, as it does not know that the subelement has changed
+  block.push_back(makeNonNegativeIntegerBlock(103, 1));
+  BOOST_CHECK(!block.hasWire());
+  BOOST_CHECK_EQUAL(block.size(), 1 + 3 + 1 + 3 + 1 + 3 + 300 + 3);
+
+  block.encode();
+  Block decoded(block.wire(), block.size());
+  decoded.parse();
+  BOOST_REQUIRE_EQUAL(decoded.elements_size(), 2);
+  BOOST_CHECK_EQUAL(decoded.elements()[0].value_size(), 1 + 3 + 300);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(decoded.elements()[1]), 1);
+
+  // encode() has consumed the modified subelement, so modifications splice again
+  block.push_back(makeNonNegativeIntegerBlock(103, 2));
+  BOOST_CHECK(block.hasWire());
+  BOOST_CHECK_EQUAL(block.size(), 1 + 3 + 1 + 3 + 1 + 3 + 300 + 3 + 3);
+  BOOST_CHECK_EQUAL(block.getBuffer()->size(), block.size());
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(block.elements().back()), 2);
+}
+
+BOOST_AUTO_TEST_CASE(SpliceInsertErase)
+{
+  static const uint8_t WIRE[] = {0x64, 0x06, 0x01, 0x01, 0x05, 0x03, 0x01, 0x05};
+  static const uint8_t INSERTED[] = {0x64, 0x09, 0x01, 0x01, 0x05, 0x02, 0x01, 0x07,
+                                     0x03, 0x01, 0x05};
+  static const uint8_t ERASED[] = {0x64, 0x03, 0x02, 0x01, 0x07};
+
+  Block block(WIRE, sizeof(WIRE));
+  block.parse();
+  block.insertElement(block.elements_begin() + 1, makeNonNegativeIntegerBlock(2, 7));
+  BOOST_CHECK(block.hasWire());
+  BOOST_CHECK_EQUAL_COLLECTIONS(block.begin(), block.end(),
+                                INSERTED, INSERTED + sizeof(INSERTED));
+  BOOST_CHECK(block.elements()[1].getBuffer() == block.getBuffer());
+
+  block.eraseElement(block.elements_begin() + 2);
+  BOOST_CHECK(block.hasWire());
+  BOOST_CHECK_EQUAL(block.size(), 8);
+
+  block.eraseElements(block.elements_begin(), block.elements_begin() + 1);
+  BOOST_CHECK(block.hasWire());
+  BOOST_CHECK_EQUAL_COLLECTIONS(block.begin(), block.end(), ERASED, ERASED + sizeof(ERASED));
+
+  // insert() returns an iterator, so it resets until encode()
+  Block::element_iterator it = block.insert(block.elements_end(), Block(4));
+  BOOST_CHECK(!block.hasWire());
+  it->push_back(makeNonNegativeIntegerBlock(5, 1));
+  block.encode();
+  block.eraseElement(block.elements_begin());
+  BOOST_CHECK(block.hasWire());
+  BOOST_CHECK_EQUAL(block.size(), 2 + 5);
+}
+
+BOOST_AUTO_TEST_CASE(InsertWithoutElements)
+{
+  // the positions are taken before the Block allocates its subelement storage
+  Block block(100);
+  Block::element_iterator it = block.insert(block.elements_end(),
+                                            makeNonNegativeIntegerBlock(2, 2));
+  BOOST_CHECK_EQUAL(it->type(), 2);
+  it = block.insert(block.elements_begin(), makeNonNegativeIntegerBlock(1, 1));
+  BOOST_CHECK_EQUAL(it->type(), 1);
+  it = block.insert(block.elements_end(), makeNonNegativeIntegerBlock(3, 3));
+  BOOST_CHECK_EQUAL(it->type(), 3);
+  BOOST_REQUIRE_EQUAL(block.elements_size(), 3);
+
+  it = block.erase(block.elements_begin() + 1);
+  BOOST_CHECK_EQUAL(it->type(), 3);
+  it = block.erase(block.elements_begin(), block.elements_end());
+  BOOST_CHECK(Block::element_const_iterator(it) == block.elements_end());
+  BOOST_CHECK_EQUAL(block.elements_size(), 0);
+  BOOST_CHECK_EQUAL(block.size(), 2);
+
+  static const uint8_t WIRE[] = {0x64, 0x03, 0x01, 0x01, 0x05};
+  Block wire(WIRE, sizeof(WIRE));
+  wire.parse();
+  it = wire.insert(wire.elements_end(), makeNonNegativeIntegerBlock(2, 7));
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(*it), 7);
+  BOOST_CHECK_EQUAL(wire.elements_size(), 2);
+}
+
+static const uint8_t INTEREST[] = {
+  0x05, 0x0f,
+        0x07, 0x03, 0x08, 0x01, 0x41,
+        0x0a, 0x04, 0x01, 0x02, 0x03, 0x04,
+        0x0c, 0x02, 0x0f, 0xa0
+};
+
+static const uint8_t NONCE[] = {0xa1, 0xa2, 0xa3, 0xa4};
+
+BOOST_AUTO_TEST_CASE(PatchCopyUnchanged)
+{
+  static const BlockPath nonce{0x0a};
+
+  Block interest(INTEREST, sizeof(INTEREST));
+  Block copy = interest;
+  interest.patch(nonce, NONCE, sizeof(NONCE));
+
+  // the shared buffer is copied once, and then patched in place
+  BOOST_CHECK(interest.getBuffer() != copy.getBuffer());
+  BOOST_CHECK_EQUAL_COLLECTIONS(copy.begin(), copy.end(), INTEREST, INTEREST + sizeof(INTEREST));
+  BOOST_CHECK_EQUAL_COLLECTIONS(interest.value_begin() + 7, interest.value_begin() + 11,
+                                NONCE, NONCE + sizeof(NONCE));
+  BOOST_CHECK_EQUAL(interest.size(), sizeof(INTEREST));
+
+  ConstBufferPtr buffer = interest.getBuffer();
+  buffer.reset();
+  const uint8_t* wire = interest.wire();
+  interest.patch(nonce, INTEREST + 9, 4);
+  BOOST_CHECK_EQUAL(interest.wire(), wire);
+  BOOST_CHECK(interest == copy);
+}
+
+BOOST_AUTO_TEST_CASE(PatchInPlace)
+{
+  static const BlockPath lifetime{0x0c};
+  static const uint8_t LIFETIME[] = {0x27, 0x10};
+
+  Block interest(INTEREST, sizeof(INTEREST));
+  interest.parse();
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(interest.get(0x0c)), 4000);
+  const Buffer* buffer = interest.getBuffer().get();
+  BlockView view(interest);
+
+  interest.patch(lifetime, LIFETIME, sizeof(LIFETIME));
+  BOOST_CHECK_EQUAL(interest.getBuffer().get(), buffer);
+  BOOST_CHECK(interest.hasWire());
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(interest.get(0x0c)), 10000);
+
+  // a view does not own the buffer, so it sees the new value
+  BOOST_CHECK_EQUAL(view.value()[13], 0x27);
+  BOOST_CHECK_EQUAL(view.value()[14], 0x10);
+}
+
+BOOST_AUTO_TEST_CASE(PatchWidthChange)
+{
+  static const BlockPath lifetime{0x0c};
+  static const uint8_t LIFETIME[] = {0x00, 0x01, 0x86, 0xa0};
+  static const uint8_t EXPECTED[] = {
+    0x05, 0x11,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+          0x0a, 0x04, 0x01, 0x02, 0x03, 0x04,
+          0x0c, 0x04, 0x00, 0x01, 0x86, 0xa0
+  };
+
+  Block interest(INTEREST, sizeof(INTEREST));
+  Block copy = interest;
+  interest.patch(lifetime, LIFETIME, sizeof(LIFETIME));
+  BOOST_CHECK(interest.hasWire());
+  BOOST_CHECK_EQUAL_COLLECTIONS(interest.begin(), interest.end(),
+                                EXPECTED, EXPECTED + sizeof(EXPECTED));
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(interest.get(0x0c)), 100000);
+  BOOST_CHECK_EQUAL_COLLECTIONS(copy.begin(), copy.end(), INTEREST, INTEREST + sizeof(INTEREST));
+}
+
+BOOST_AUTO_TEST_CASE(PatchNested)
+{
+  static const BlockPath component{0x07, {0x08, 1}};
+  static const uint8_t DATA[] = {
+    0x06, 0x0a,
+          0x07, 0x08, 0x08, 0x01, 0x41, 0x08, 0x03, 0x42, 0x43, 0x44
+  };
+  static const uint8_t SAME_WIDTH[] = {'x', 'y', 'z'};
+  static const uint8_t EXPECTED[] = {
+    0x06, 0x08,
+          0x07, 0x06, 0x08, 0x01, 0x41, 0x08, 0x01, 'w'
+  };
+
+  Block data(DATA, sizeof(DATA));
+  data.parse();
+  data.patch(component, SAME_WIDTH, sizeof(SAME_WIDTH));
+  BOOST_CHECK_EQUAL(data.size(), sizeof(DATA));
+  Block name = data.get(0x07);
+  name.parse();
+  BOOST_CHECK_EQUAL(readString(name.elements()[1]), "xyz");
+
+  static const uint8_t NARROWER[] = {'w'};
+  data.patch(component, NARROWER, sizeof(NARROWER));
+  BOOST_CHECK(data.hasWire());
+  BOOST_CHECK_EQUAL_COLLECTIONS(data.begin(), data.end(), EXPECTED, EXPECTED + sizeof(EXPECTED));
+  name = data.get(0x07);
+  name.parse();
+  BOOST_CHECK_EQUAL(readString(name.elements()[1]), "w");
+}
+
+BOOST_AUTO_TEST_CASE(PatchNotFound)
+{
+  Block interest(INTEREST, sizeof(INTEREST));
+  BOOST_CHECK_THROW(interest.patch(BlockPath{0x0b}, NONCE, sizeof(NONCE)), Block::Error);
+  BOOST_CHECK_THROW(interest.patch(BlockPath{{0x0a, 1}}, NONCE, sizeof(NONCE)), Block::Error);
+  BOOST_CHECK_THROW(interest.patch(BlockPath{0x07, 0x09}, NONCE, sizeof(NONCE)), Block::Error);
+  BOOST_CHECK_EQUAL_COLLECTIONS(interest.begin(), interest.end(),
+                                INTEREST, INTEREST + sizeof(INTEREST));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBlockModification
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../block-path.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestBlockPath)
+
+static const uint8_t INTEREST[] = {
+  0x05, 0x14,
+        0x07, 0x09,
+              0x08, 0x01, 0x41,
+              0x08, 0x01, 0x42,
+              0x08, 0x01, 0x43,
+        0x0a, 0x04, 0x01, 0x02, 0x03, 0x04,
+        0x0c, 0x01, 0x64
+};
+
+BOOST_AUTO_TEST_CASE(Construct)
+{
+  BlockPath path{0x07, {0x08, 2}};
+  BOOST_REQUIRE_EQUAL(path.size(), 2);
+  BOOST_CHECK_EQUAL(path[0].type, 0x07);
+  BOOST_CHECK_EQUAL(path[0].index, 0);
+  BOOST_CHECK_EQUAL(path[1].type, 0x08);
+  BOOST_CHECK_EQUAL(path[1].index, 2);
+
+  BOOST_CHECK_THROW(BlockPath({}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(Evaluate)
+{
+  Block interest(INTEREST, sizeof(INTEREST));
+
+  static const BlockPath thirdComponent{0x07, {0x08, 2}};
+  BlockView component = thirdComponent.evaluate(interest);
+  BOOST_REQUIRE(!component.empty());
+  BOOST_CHECK_EQUAL(component.type(), 0x08);
+  BOOST_CHECK_EQUAL(component.value_size(), 1);
+  BOOST_CHECK_EQUAL(*component.value(), 0x43);
+  // the view refers to the wire encoding of the Block, which is not parsed
+  BOOST_CHECK(component.wire() == interest.wire() + 10);
+  BOOST_CHECK_EQUAL(interest.elements_size(), 0);
+
+  static const BlockPath lifetime{0x0c};
+  BlockView element = lifetime.evaluate(interest);
+  BOOST_REQUIRE(!element.empty());
+  BOOST_CHECK_EQUAL(*element.value(), 0x64);
+
+  // evaluation on a range starts from the elements in it
+  element = thirdComponent.evaluate(interest.value(), interest.value() + interest.value_size());
+  BOOST_CHECK(element.wire() == component.wire());
+  element = BlockPath{0x05, 0x0a}.evaluate(INTEREST, INTEREST + sizeof(INTEREST));
+  BOOST_REQUIRE(!element.empty());
+  BOOST_CHECK_EQUAL(element.value_size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(NotFound)
+{
+  Block interest(INTEREST, sizeof(INTEREST));
+
+  // no element of the type
+  BOOST_CHECK(BlockPath{0x0b}.evaluate(interest).empty());
+  BOOST_CHECK((BlockPath{0x07, 0x09}.evaluate(interest).empty()));
+  // index past the last element of the type
+  BOOST_CHECK((BlockPath{{0x07, 1}}.evaluate(interest).empty()));
+  BOOST_CHECK((BlockPath{0x07, {0x08, 3}}.evaluate(interest).empty()));
+  // the Block itself is not selected by the first step
+  BOOST_CHECK(BlockPath{0x05}.evaluate(interest).empty());
+  // no value
+  BOOST_CHECK(BlockPath{0x07}.evaluate(Block(0x05)).empty());
+  BOOST_CHECK((BlockPath{0x07}.evaluate(INTEREST, INTEREST).empty()));
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  Block interest(INTEREST, sizeof(INTEREST));
+
+  // a step into a value that is not TLV
+  BOOST_CHECK((BlockPath{0x0c, 0x64}.evaluate(interest).empty()));
+  BOOST_CHECK((BlockPath{0x07, 0x08, 0x41}.evaluate(interest).empty()));
+
+  // TLV-LENGTH of Nonce exceeds the value of the Interest
+  static const uint8_t TRUNCATED[] = {
+    0x05, 0x0b,
+          0x07, 0x03,
+                0x08, 0x01, 0x41,
+          0x0a, 0x08, 0x01, 0x02, 0x03, 0x04
+  };
+  Block truncated(TRUNCATED, sizeof(TRUNCATED));
+  BOOST_CHECK(!BlockPath{0x07}.evaluate(truncated).empty());
+  BOOST_CHECK(BlockPath{0x0a}.evaluate(truncated).empty());
+  BOOST_CHECK(BlockPath{0x0c}.evaluate(truncated).empty());
+
+  // an element following the target is not decoded
+  BOOST_CHECK(!BlockPath::findElement(TRUNCATED + 2, TRUNCATED + sizeof(TRUNCATED),
+                                      BlockPath::Step(0x07)).empty());
+  BOOST_CHECK(BlockPath::findElement(TRUNCATED + 2, TRUNCATED + sizeof(TRUNCATED),
+                                     BlockPath::Step(0x07, 1)).empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBlockPath
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../block-tree.hpp"
+#include "../block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestBlockTree)
+
+static const uint8_t INTEREST[] = {
+  0x05, 0x12,
+        0x07, 0x08,
+              0x08, 0x01, 0x41,
+              0x08, 0x03, 0x01, 0x01, 0x05, // a component that happens to be valid TLV
+        0x0a, 0x04, 0x01, 0x02, 0x03, 0x04, // a Nonce that happens to be valid TLV
+        0x0c, 0x00
+};
+
+BOOST_AUTO_TEST_CASE(PacketTypes)
+{
+  Block interest(INTEREST, sizeof(INTEREST));
+  BlockTree tree(interest);
+  BOOST_CHECK_EQUAL(tree.size(), 6);
+
+  const BlockTree::Node& root = tree.root();
+  BOOST_CHECK_EQUAL(root.type, tlv::Interest);
+  BOOST_REQUIRE_EQUAL(root.nChildren, 3);
+
+  const BlockTree::Node* name = tree.find(root, tlv::Name);
+  BOOST_REQUIRE(name != nullptr);
+  BOOST_REQUIRE_EQUAL(name->nChildren, 2);
+  BOOST_CHECK_EQUAL(tree.elements_begin(*name)[1].nChildren, 0);
+  BOOST_CHECK_EQUAL(tree.elements_begin(*name)[1].valueSize, 3);
+
+  const BlockTree::Node* nonce = tree.find(root, tlv::Nonce);
+  BOOST_REQUIRE(nonce != nullptr);
+  BOOST_CHECK_EQUAL(nonce->nChildren, 0);
+  BOOST_CHECK_EQUAL(nonce->valueSize, 4);
+  BOOST_CHECK(tree.find(root, tlv::Content) == nullptr);
+
+  Block nonceBlock = tree.toBlock(*nonce);
+  BOOST_CHECK(nonceBlock.getBuffer() == interest.getBuffer());
+  BOOST_CHECK_EQUAL(nonceBlock.size(), 6);
+  BOOST_CHECK_EQUAL(tree.view(*nonce).value()[3], 0x04);
+}
+
+BOOST_AUTO_TEST_CASE(CustomPredicate)
+{
+  Block interest(INTEREST, sizeof(INTEREST));
+  BlockTree tree(interest, BlockTree::DEFAULT_MAX_DEPTH, [] (uint32_t type) {
+      return type == tlv::Nonce || BlockTree::isNestedPacketType(type);
+    });
+  BOOST_CHECK_EQUAL(tree.size(), 7);
+  const BlockTree::Node* nonce = tree.find(tree.root(), tlv::Nonce);
+  BOOST_REQUIRE(nonce != nullptr);
+  BOOST_CHECK_EQUAL(nonce->nChildren, 1);
+
+  BOOST_CHECK_THROW(BlockTree(interest, 4, nullptr), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(MaxDepth)
+{
+  Block interest(INTEREST, sizeof(INTEREST));
+  BOOST_CHECK_EQUAL(BlockTree(interest, 0).size(), 1);
+  BOOST_CHECK_EQUAL(BlockTree(interest, 1).size(), 4);
+  BOOST_CHECK_EQUAL(BlockTree(interest, 2).size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  static const uint8_t WIRE[] = {
+    0x06, 0x05,
+          0x14, 0x03, 0x19, 0x02, 0x01 // FreshnessPeriod exceeds MetaInfo
+  };
+  Block data(WIRE, sizeof(WIRE));
+  BOOST_CHECK_THROW(BlockTree tree(data), tlv::Error);
+  BOOST_CHECK_EQUAL(BlockTree(data, 1).size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBlockTree
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../block-view.hpp"
+#include "../block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+static_assert(!std::is_convertible<Block, BlockView>::value,
+              "Block must be converted to BlockView explicitly");
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestBlockView)
+
+static const uint8_t WIRE[] = {
+  0x64, 0x0c,
+        0x07, 0x03, 0x08, 0x01, 0x41,
+        0x0a, 0x01, 0x05,
+        0x0a, 0x02, 0x01, 0x00
+};
+
+BOOST_AUTO_TEST_CASE(Iterate)
+{
+  Block block(WIRE, sizeof(WIRE));
+  BlockView view(block);
+  BOOST_CHECK_EQUAL(view.type(), 0x64);
+  BOOST_CHECK_EQUAL(view.wire(), block.wire());
+  BOOST_CHECK_EQUAL(view.size(), sizeof(WIRE));
+  BOOST_CHECK_EQUAL(view.value_size(), 12);
+
+  std::vector<uint32_t> types;
+  std::vector<size_t> sizes;
+  for (auto it = view.elements_begin(); it != view.elements_end(); ++it) {
+    types.push_back(it->type());
+    sizes.push_back(it->size());
+  }
+  std::vector<uint32_t> expectedTypes{0x07, 0x0a, 0x0a};
+  std::vector<size_t> expectedSizes{5, 3, 4};
+  BOOST_CHECK_EQUAL_COLLECTIONS(types.begin(), types.end(),
+                                expectedTypes.begin(), expectedTypes.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(sizes.begin(), sizes.end(),
+                                expectedSizes.begin(), expectedSizes.end());
+
+  BOOST_CHECK_EQUAL(view.find(0x0a)->value()[0], 0x05);
+  BOOST_CHECK(view.find(0x0b) == view.elements_end());
+  BOOST_CHECK_EQUAL(view.get(0x07).get(0x08).value()[0], 0x41);
+  BOOST_CHECK_THROW(view.get(0x0b), Block::Error);
+
+  BOOST_CHECK_THROW(BlockView(Block(100)), Block::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  static const uint8_t MALFORMED[] = {
+    0x64, 0x06,
+          0x0a, 0x01, 0x05,
+          0x0b, 0x05, 0x00
+  };
+  BlockView view(MALFORMED, sizeof(MALFORMED));
+  BOOST_CHECK_EQUAL(view.find(0x0a)->type(), 0x0a);
+  BOOST_CHECK_THROW(view.find(0x0b), tlv::Error);
+
+  BOOST_CHECK_THROW(BlockView(MALFORMED, 4), tlv::Error);
+  BOOST_CHECK_THROW(BlockView(MALFORMED, 1), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(FromBuffer)
+{
+  bool isOk = false;
+  BlockView view;
+  std::tie(isOk, view) = BlockView::fromBuffer(WIRE, sizeof(WIRE));
+  BOOST_REQUIRE(isOk);
+  BOOST_CHECK_EQUAL(view.type(), 0x64);
+  BOOST_CHECK_EQUAL(view.size(), sizeof(WIRE));
+
+  // the buffer may hold more than the element
+  std::tie(isOk, view) = BlockView::fromBuffer(WIRE + 2, sizeof(WIRE) - 2);
+  BOOST_REQUIRE(isOk);
+  BOOST_CHECK_EQUAL(view.type(), 0x07);
+  BOOST_CHECK_EQUAL(view.size(), 5);
+
+  std::tie(isOk, view) = BlockView::fromBuffer(WIRE, sizeof(WIRE) - 1);
+  BOOST_CHECK(!isOk);
+  std::tie(isOk, view) = BlockView::fromBuffer(WIRE, 1);
+  BOOST_CHECK(!isOk);
+  std::tie(isOk, view) = BlockView::fromBuffer(WIRE, 0);
+  BOOST_CHECK(!isOk);
+}
+
+BOOST_AUTO_TEST_CASE(ToBlock)
+{
+  Block owner(WIRE, sizeof(WIRE));
+  BlockView view(owner);
+  BlockView name = view.get(0x07);
+
+  Block block = name.toBlock(owner);
+  BOOST_CHECK(block.getBuffer() == owner.getBuffer());
+  BOOST_CHECK_EQUAL(block.type(), 0x07);
+  BOOST_CHECK_EQUAL(block.size(), 5);
+  BOOST_CHECK_EQUAL(block.value_size(), 3);
+
+  Block copy = name.toBlock();
+  BOOST_CHECK(copy.getBuffer() != owner.getBuffer());
+  BOOST_CHECK(copy == block);
+
+  // the view must lie within the buffer of the owner
+  Block other(WIRE, sizeof(WIRE));
+  BOOST_CHECK_THROW(name.toBlock(other), Block::Error);
+  BOOST_CHECK_THROW(name.toBlock(Block(100)), Block::Error);
+  BOOST_CHECK_THROW(BlockView().toBlock(owner), Block::Error);
+  BOOST_CHECK_THROW(BlockView().toBlock(), Block::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBlockView
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../block-visitor.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tlv {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestBlockVisitor)
+
+static const uint8_t DATA[] = {
+  0x06, 0x12,
+        0x07, 0x06,
+              0x08, 0x01, 0x41,
+              0x08, 0x01, 0x42,
+        0x14, 0x03,
+              0x19, 0x01, 0x05,
+        0x15, 0x03,
+              0x20, 0x01, 0x43
+};
+
+/** @brief Descend into the containers of DATA, and skip the leaves, whose values are opaque
+ */
+static VisitAction
+descendContainers(uint32_t type)
+{
+  return type == 0x06 || type == 0x07 || type == 0x14 || type == 0x15 ?
+         VisitAction::DESCEND : VisitAction::SKIP;
+}
+
+/** @brief Visitor recording "+type@depth" on enter and "-type@depth" on leave
+ */
+class RecordingVisitor
+{
+public:
+  explicit
+  RecordingVisitor(VisitAction (*decide)(uint32_t type) = &descendContainers)
+    : m_decide(decide)
+  {
+  }
+
+  VisitAction
+  enter(uint32_t type, const uint8_t* valueBegin, const uint8_t* valueEnd, size_t depth)
+  {
+    events.push_back("+" + std::to_string(type) + "@" + std::to_string(depth));
+    return m_decide(type);
+  }
+
+  void
+  leave(uint32_t type, const uint8_t* valueBegin, const uint8_t* valueEnd, size_t depth)
+  {
+    events.push_back("-" + std::to_string(type) + "@" + std::to_string(depth));
+  }
+
+public:
+  std::vector<std::string> events;
+
+private:
+  VisitAction (*m_decide)(uint32_t type);
+};
+
+BOOST_AUTO_TEST_CASE(Descend)
+{
+  RecordingVisitor visitor;
+  BOOST_CHECK(visitElements(DATA, DATA + sizeof(DATA), visitor));
+
+  std::vector<std::string> expected{
+    "+6@0",
+      "+7@1", "+8@2", "-8@2", "+8@2", "-8@2", "-7@1",
+      "+20@1", "+25@2", "-25@2", "-20@1",
+      "+21@1", "+32@2", "-32@2", "-21@1",
+    "-6@0"
+  };
+  BOOST_CHECK_EQUAL_COLLECTIONS(visitor.events.begin(), visitor.events.end(),
+                                expected.begin(), expected.end());
+
+  // the same walk through a Block
+  RecordingVisitor blockVisitor;
+  BOOST_CHECK(visitElements(Block(DATA, sizeof(DATA)), blockVisitor));
+  BOOST_CHECK_EQUAL_COLLECTIONS(blockVisitor.events.begin(), blockVisitor.events.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Skip)
+{
+  RecordingVisitor visitor([] (uint32_t type) {
+    return type == 0x07 || type == 0x15 ? VisitAction::SKIP : descendContainers(type);
+  });
+  BOOST_CHECK(visitElements(DATA, DATA + sizeof(DATA), visitor));
+
+  std::vector<std::string> expected{
+    "+6@0", "+7@1", "-7@1", "+20@1", "+25@2", "-25@2", "-20@1", "+21@1", "-21@1", "-6@0"
+  };
+  BOOST_CHECK_EQUAL_COLLECTIONS(visitor.events.begin(), visitor.events.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Stop)
+{
+  RecordingVisitor visitor([] (uint32_t type) {
+    return type == 0x19 ? VisitAction::STOP : descendContainers(type);
+  });
+  BOOST_CHECK(visitElements(DATA, DATA + sizeof(DATA), visitor));
+
+  // leave() is not called for the stopping element or its ancestors
+  std::vector<std::string> expected{
+    "+6@0", "+7@1", "+8@2", "-8@2", "+8@2", "-8@2", "-7@1", "+20@1", "+25@2"
+  };
+  BOOST_CHECK_EQUAL_COLLECTIONS(visitor.events.begin(), visitor.events.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(MaxDepth)
+{
+  RecordingVisitor visitor;
+  BOOST_CHECK(visitElements(DATA, DATA + sizeof(DATA), visitor, 1));
+
+  std::vector<std::string> expected{
+    "+6@0", "+7@1", "-7@1", "+20@1", "-20@1", "+21@1", "-21@1", "-6@0"
+  };
+  BOOST_CHECK_EQUAL_COLLECTIONS(visitor.events.begin(), visitor.events.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  // Content holds opaque bytes, which are malformed as TLV
+  static const uint8_t WIRE[] = {
+    0x06, 0x09,
+          0x07, 0x03,
+                0x08, 0x01, 0x41,
+          0x15, 0x02,
+                0x20, 0x05
+  };
+
+  RecordingVisitor descending;
+  BOOST_CHECK(!visitElements(WIRE, WIRE + sizeof(WIRE), descending));
+  std::vector<std::string> expected{"+6@0", "+7@1", "+8@2", "-8@2", "-7@1", "+21@1"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(descending.events.begin(), descending.events.end(),
+                                expected.begin(), expected.end());
+
+  // the value of a skipped element is not decoded
+  RecordingVisitor skipping([] (uint32_t type) {
+    return type == 0x15 ? VisitAction::SKIP : descendContainers(type);
+  });
+  BOOST_CHECK(visitElements(WIRE, WIRE + sizeof(WIRE), skipping));
+
+  // TLV-LENGTH exceeds the input
+  RecordingVisitor truncated;
+  BOOST_CHECK(!visitElements(WIRE, WIRE + sizeof(WIRE) - 1, truncated));
+  BOOST_CHECK(truncated.events.empty());
+
+  RecordingVisitor empty;
+  BOOST_CHECK(visitElements(WIRE, WIRE, empty));
+  BOOST_CHECK(empty.events.empty());
+
+  BOOST_CHECK_THROW(visitElements(Block(0x06), RecordingVisitor()), Block::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBlockVisitor
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace tlv
+} // namespace ndn
@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../block.hpp"
+#include "../block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#include <sstream>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestBlock)
+
+BOOST_AUTO_TEST_CASE(FromStream)
+{
+  std::string wire;
+  // 2-octet TLV-TYPE, value of 300 octets
+  wire += std::string("\xfd\x01\x00\xfd\x01\x2c", 6) + std::string(300, '\xaa');
+  // empty value
+  wire += std::string("\x07\x00", 2);
+  // nested elements
+  wire += std::string("\x64\x05\x0a\x01\x05\x0b\x00", 7);
+  std::istringstream is(wire);
+
+  Block first = Block::fromStream(is);
+  BOOST_CHECK_EQUAL(first.type(), 0x100);
+  BOOST_CHECK_EQUAL(first.value_size(), 300);
+  BOOST_CHECK_EQUAL(first.size(), 306);
+  BOOST_CHECK_EQUAL(first.getBuffer()->size(), 306);
+  BOOST_CHECK_EQUAL(first.value()[299], 0xaa);
+
+  Block second = Block::fromStream(is);
+  BOOST_CHECK_EQUAL(second.type(), 0x07);
+  BOOST_CHECK_EQUAL(second.value_size(), 0);
+
+  Block third = Block::fromStream(is);
+  BOOST_CHECK_EQUAL(third.type(), 0x64);
+  third.parse();
+  BOOST_CHECK_EQUAL(third.elements_size(), 2);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(third.get(0x0a)), 5);
+
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char*>(first.wire()), first.size()) +
+                    std::string(reinterpret_cast<const char*>(second.wire()), second.size()) +
+                    std::string(reinterpret_cast<const char*>(third.wire()), third.size()),
+                    wire);
+
+  // end of stream
+  BOOST_CHECK_THROW(Block::fromStream(is), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(FromStreamTruncated)
+{
+  // truncated TLV-TYPE
+  std::istringstream truncatedType(std::string("\xfd\x01", 2));
+  BOOST_CHECK_THROW(Block::fromStream(truncatedType), tlv::Error);
+  BOOST_CHECK(truncatedType.fail());
+
+  // missing TLV-LENGTH
+  std::istringstream missingLength(std::string("\x07", 1));
+  BOOST_CHECK_THROW(Block::fromStream(missingLength), tlv::Error);
+  BOOST_CHECK(missingLength.fail());
+
+  // truncated TLV-LENGTH
+  std::istringstream truncatedLength(std::string("\x07\xfe\x00\x00", 4));
+  BOOST_CHECK_THROW(Block::fromStream(truncatedLength), tlv::Error);
+
+  // truncated value
+  std::istringstream truncatedValue(std::string("\x07\x03\x08\x01", 4));
+  BOOST_CHECK_THROW(Block::fromStream(truncatedValue), tlv::Error);
+  BOOST_CHECK(truncatedValue.fail());
+
+  // a complete Block followed by a truncated one
+  std::istringstream partial(std::string("\x07\x01\x41\x07\x02\x41", 6));
+  Block block = Block::fromStream(partial);
+  BOOST_CHECK_EQUAL(block.value_size(), 1);
+  BOOST_CHECK_THROW(Block::fromStream(partial), tlv::Error);
+
+  // TLV-LENGTH exceeds MAX_SIZE_OF_BLOCK_FROM_STREAM
+  std::istringstream tooLarge(std::string("\x07\xfe\x00\x01\x00\x00", 6));
+  BOOST_CHECK_THROW(Block::fromStream(tooLarge), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(FindInWire)
+{
+  static const uint8_t WIRE[] = {
+    0x64, 0x0b,
+          0x07, 0x03, 0x08, 0x01, 0x41,
+          0x0a, 0x01, 0x05,
+          0x0a, 0x01, 0x06
+  };
+
+  Block block(WIRE, sizeof(WIRE));
+  bool isFound = false;
+  Block element;
+  std::tie(isFound, element) = block.findInWire(0x07);
+  BOOST_REQUIRE(isFound);
+  BOOST_CHECK_EQUAL(element.size(), 5);
+  BOOST_CHECK(element.getBuffer() == block.getBuffer());
+  BOOST_CHECK_EQUAL(block.elements_size(), 0);
+
+  std::tie(isFound, element) = block.findInWire(0x0a);
+  BOOST_REQUIRE(isFound);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(element), 5);
+
+  std::tie(isFound, element) = block.findInWire(0x0b);
+  BOOST_CHECK(!isFound);
+
+  // a malformed element is not skipped over
+  static const uint8_t MALFORMED[] = {
+    0x64, 0x06,
+          0x07, 0x09, 0x08, 0x01, 0x41,
+          0x0a
+  };
+  Block malformed(MALFORMED, sizeof(MALFORMED));
+  std::tie(isFound, element) = malformed.findInWire(0x0a);
+  BOOST_CHECK(!isFound);
+
+  // a Block without wire encoding is searched among its subelements
+  Block unencoded(100);
+  unencoded.push_back(makeNonNegativeIntegerBlock(0x0a, 7));
+  std::tie(isFound, element) = unencoded.findInWire(0x0a);
+  BOOST_REQUIRE(isFound);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(element), 7);
+}
+
+BOOST_AUTO_TEST_CASE(FromBufferNoThrow)
+{
+  static const uint8_t WIRE[] = {
+    0x64, 0x05,
+          0x0a, 0x01, 0x05,
+          0x0b, 0x00
+  };
+  ConstBufferPtr buffer = make_shared<Buffer>(WIRE, sizeof(WIRE));
+
+  bool isOk = false;
+  Block block;
+  std::tie(isOk, block) = Block::fromBuffer(buffer);
+  BOOST_CHECK(isOk);
+  BOOST_CHECK_EQUAL(block.size(), 7);
+
+  // the range holds more than the TLV
+  std::tie(isOk, block) = Block::fromBuffer(buffer, buffer->begin() + 2, buffer->end());
+  BOOST_CHECK(!isOk);
+  BOOST_CHECK(block.empty());
+  std::tie(isOk, block) = Block::fromBuffer(buffer, buffer->begin() + 2, buffer->end(), false);
+  BOOST_CHECK(isOk);
+  BOOST_CHECK_EQUAL(block.type(), 0x0a);
+
+  // truncated value
+  std::tie(isOk, block) = Block::fromBuffer(buffer, buffer->begin(), buffer->end() - 1, false);
+  BOOST_CHECK(!isOk);
+
+  // offset at or past the end of the buffer
+  std::tie(isOk, block) = Block::fromBuffer(buffer, buffer->size());
+  BOOST_CHECK(!isOk);
+  std::tie(isOk, block) = Block::fromBuffer(buffer, buffer->size() + 1);
+  BOOST_CHECK(!isOk);
+
+  // range outside the buffer
+  ConstBufferPtr other = make_shared<Buffer>(WIRE, sizeof(WIRE));
+  std::tie(isOk, block) = Block::fromBuffer(buffer, other->begin(), other->end());
+  BOOST_CHECK(!isOk);
+
+  std::tie(isOk, block) = Block::fromBuffer(WIRE, sizeof(WIRE) - 1);
+  BOOST_CHECK(!isOk);
+}
+
+BOOST_AUTO_TEST_CASE(TryParse)
+{
+  static const uint8_t WIRE[] = {
+    0x64, 0x05,
+          0x0a, 0x01, 0x05,
+          0x0b, 0x00
+  };
+  Block block(WIRE, sizeof(WIRE));
+  BOOST_CHECK(block.tryParse());
+  BOOST_CHECK_EQUAL(block.elements_size(), 2);
+
+  // TLV-LENGTH of the second element exceeds the value
+  static const uint8_t MALFORMED[] = {
+    0x64, 0x05,
+          0x0a, 0x01, 0x05,
+          0x0b, 0x01
+  };
+  Block malformed(MALFORMED, sizeof(MALFORMED));
+  BOOST_CHECK(!malformed.tryParse());
+  BOOST_CHECK_EQUAL(malformed.elements_size(), 0);
+  BOOST_CHECK_THROW(malformed.parse(), tlv::Error);
+}
+
+// needs 4 GiB of memory, so it runs only on request: --run_test=Encoding/TestBlock/OffsetLimit
+BOOST_AUTO_TEST_CASE(OffsetLimit, *boost::unit_test::disabled())
+{
+  BufferPtr buffer = make_shared<Buffer>(static_cast<size_t>(1) << 32);
+  BOOST_CHECK_THROW(Block(tlv::Content, buffer), Block::Error);
+
+  Buffer::const_iterator end = buffer->end();
+  BOOST_CHECK_THROW(Block(buffer, tlv::Content, end - 2, end, end, end), Block::Error);
+
+  Buffer::const_iterator begin = buffer->begin() + 0xfffffff0;
+  Block block(buffer, tlv::Content, begin, begin + 2, begin + 2, begin + 2);
+  BOOST_CHECK_EQUAL(block.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBlock
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../buffer.hpp"
+#include "../block.hpp"
+#include "../block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#include <sstream>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestBuffer)
+
+static const uint8_t WIRE[] = {
+  0x64, 0x0b,
+        0x01, 0x01, 0x05,
+        0x02, 0x02, 0x01, 0x00,
+        0x03, 0x02, 0xff, 0xff
+};
+
+BOOST_AUTO_TEST_CASE(TailPadding)
+{
+  Buffer padded(WIRE, sizeof(WIRE), Buffer::TailPaddingTag());
+  BOOST_CHECK_EQUAL(padded.size(), sizeof(WIRE) + Buffer::TAIL_PADDING);
+  BOOST_CHECK(std::all_of(padded.begin() + sizeof(WIRE), padded.end(),
+                          [] (uint8_t octet) { return octet == 0; }));
+
+  Buffer empty(4, Buffer::TailPaddingTag());
+  BOOST_CHECK_EQUAL(empty.size(), 4 + Buffer::TAIL_PADDING);
+}
+
+BOOST_AUTO_TEST_CASE(IsReadable)
+{
+  Buffer exact(WIRE, sizeof(WIRE));
+  BOOST_CHECK(exact.isReadable(exact.data(), sizeof(WIRE)));
+  BOOST_CHECK(!exact.isReadable(exact.data(), sizeof(WIRE) + 1));
+  BOOST_CHECK(exact.isReadable(exact.data() + sizeof(WIRE), 0));
+  BOOST_CHECK(!exact.isReadable(exact.data() + sizeof(WIRE) - 4, 8));
+
+  Buffer padded(WIRE, sizeof(WIRE), Buffer::TailPaddingTag());
+  BOOST_CHECK(padded.isReadable(padded.data() + sizeof(WIRE) - 4, 8));
+  BOOST_CHECK(padded.isReadable(padded.data() + sizeof(WIRE), Buffer::TAIL_PADDING));
+}
+
+BOOST_AUTO_TEST_CASE(DecodePadded)
+{
+  // the same values are decoded whether or not the decoders may read past the encoding
+  ConstBufferPtr padded = make_shared<Buffer>(WIRE, sizeof(WIRE), Buffer::TailPaddingTag());
+  ConstBufferPtr exact = make_shared<Buffer>(WIRE, sizeof(WIRE));
+
+  for (const ConstBufferPtr& buffer : {padded, exact}) {
+    Block block(buffer, buffer->begin(), buffer->begin() + sizeof(WIRE));
+    BOOST_CHECK_EQUAL(block.size(), sizeof(WIRE));
+    block.parse();
+    BOOST_REQUIRE_EQUAL(block.elements_size(), 3);
+    BOOST_CHECK_EQUAL(readNonNegativeInteger(block.get(1)), 5);
+    BOOST_CHECK_EQUAL(readNonNegativeInteger(block.get(2)), 256);
+    BOOST_CHECK_EQUAL(readNonNegativeInteger(block.get(3)), 65535);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ExactBuffersByDefault)
+{
+  // Blocks create buffers of the size of their encoding, which can then be reused whole
+  Block fromMemory(WIRE, sizeof(WIRE));
+  BOOST_CHECK_EQUAL(fromMemory.getBuffer()->size(), sizeof(WIRE));
+  BOOST_CHECK_NO_THROW(Block(fromMemory.getBuffer()));
+
+  std::stringstream stream(std::string(reinterpret_cast<const char*>(WIRE), sizeof(WIRE)));
+  Block fromStream = Block::fromStream(stream);
+  BOOST_CHECK_EQUAL(fromStream.getBuffer()->size(), sizeof(WIRE));
+  BOOST_CHECK_NO_THROW(Block(fromStream.getBuffer()));
+
+  Block encoded(100);
+  encoded.push_back(makeNonNegativeIntegerBlock(1, 5));
+  encoded.encode();
+  BOOST_CHECK_EQUAL(encoded.getBuffer()->size(), encoded.size());
+
+  encoded.push_back(makeNonNegativeIntegerBlock(2, 256));
+  BOOST_CHECK(encoded.hasWire());
+  BOOST_CHECK_EQUAL(encoded.getBuffer()->size(), encoded.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestBuffer
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../cpu-dispatch.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace ndn {
+namespace encoding {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestCpuDispatch)
+
+static const char* const LEVEL_NAMES[] = {"scalar", "sse4.2", "avx2", "avx512"};
+
+/** @brief Restores NDN_ENCODING_SIMD when the test case ends
+ */
+class SimdEnvironmentFixture
+{
+public:
+  SimdEnvironmentFixture()
+  {
+    const char* value = std::getenv("NDN_ENCODING_SIMD");
+    m_hasValue = value != nullptr;
+    if (m_hasValue)
+      m_value = value;
+  }
+
+  ~SimdEnvironmentFixture()
+  {
+    if (m_hasValue)
+      setenv("NDN_ENCODING_SIMD", m_value.c_str(), 1);
+    else
+      unsetenv("NDN_ENCODING_SIMD");
+  }
+
+private:
+  bool m_hasValue;
+  std::string m_value;
+};
+
+BOOST_AUTO_TEST_CASE(ParseLevel)
+{
+  for (size_t i = 0; i < 4; ++i) {
+    SimdLevel level = parseSimdLevel(LEVEL_NAMES[i]);
+    BOOST_CHECK_EQUAL(static_cast<size_t>(level), i);
+    BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(level), LEVEL_NAMES[i]);
+  }
+
+  BOOST_CHECK_THROW(parseSimdLevel("avx3"), std::invalid_argument);
+  BOOST_CHECK_THROW(parseSimdLevel("AVX2"), std::invalid_argument);
+  BOOST_CHECK_THROW(parseSimdLevel(""), std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(SelectFromEnvironment, SimdEnvironmentFixture)
+{
+  unsetenv("NDN_ENCODING_SIMD");
+  BOOST_CHECK_EQUAL(selectSimdLevel(), detectSimdLevel());
+
+  for (const char* name : LEVEL_NAMES) {
+    setenv("NDN_ENCODING_SIMD", name, 1);
+    BOOST_CHECK_EQUAL(selectSimdLevel(), std::min(parseSimdLevel(name), detectSimdLevel()));
+  }
+
+  setenv("NDN_ENCODING_SIMD", "sse5", 1);
+  BOOST_CHECK_THROW(selectSimdLevel(), std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(EqualAtEveryLevel, SimdEnvironmentFixture)
+{
+  // lengths around every vector width, with a difference at every position
+  std::vector<uint8_t> first(200);
+  for (size_t i = 0; i < first.size(); ++i) {
+    first[i] = static_cast<uint8_t>(i * 7 + 3);
+  }
+
+  for (const char* name : LEVEL_NAMES) {
+    BOOST_TEST_MESSAGE("NDN_ENCODING_SIMD=" << name);
+    setenv("NDN_ENCODING_SIMD", name, 1);
+    const SimdKernels& kernels = getSimdKernels(selectSimdLevel());
+    BOOST_CHECK_EQUAL(kernels.level, std::min(parseSimdLevel(name), detectSimdLevel()));
+
+    for (size_t length = 0; length <= first.size(); ++length) {
+      std::vector<uint8_t> second(first.begin(), first.begin() + length);
+      BOOST_CHECK(kernels.equal(first.data(), second.data(), length));
+
+      for (size_t pos = 0; pos < length; ++pos) {
+        second[pos] ^= 0x80;
+        bool isEqual = std::memcmp(first.data(), second.data(), length) == 0;
+        if (kernels.equal(first.data(), second.data(), length) != isEqual)
+          BOOST_ERROR("length " << length << ", difference at " << pos);
+        second[pos] ^= 0x80;
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestCpuDispatch
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace encoding
+} // namespace ndn
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../gather-encoder.hpp"
+#include "../block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace encoding {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestGatherEncoder)
+
+static std::vector<uint8_t>
+concatenate(const GatherEncoder& encoder)
+{
+  std::vector<uint8_t> octets;
+  for (const boost::asio::const_buffer& buffer : encoder.buffers()) {
+    const uint8_t* data = boost::asio::buffer_cast<const uint8_t*>(buffer);
+    octets.insert(octets.end(), data, data + boost::asio::buffer_size(buffer));
+  }
+  return octets;
+}
+
+static ConstBufferPtr
+makePayload(size_t size)
+{
+  BufferPtr payload = make_shared<Buffer>(size);
+  for (size_t i = 0; i < size; ++i) {
+    (*payload)[i] = static_cast<uint8_t>(i);
+  }
+  return payload;
+}
+
+/** @brief Check that the gathered buffers equal the encoding, and count those referencing
+ *         the buffer of @p large
+ */
+static size_t
+checkGathered(const Block& block, const ConstBufferPtr& large)
+{
+  GatherEncoder encoder;
+  BOOST_CHECK_EQUAL(encoder.appendBlock(block), block.size());
+  BOOST_CHECK_EQUAL(encoder.size(), block.size());
+
+  Block encoded = block;
+  encoded.encode();
+  std::vector<uint8_t> gathered = concatenate(encoder);
+  BOOST_CHECK_EQUAL_COLLECTIONS(gathered.begin(), gathered.end(), encoded.begin(), encoded.end());
+
+  size_t nReferences = 0;
+  for (const boost::asio::const_buffer& buffer : encoder.buffers()) {
+    const uint8_t* data = boost::asio::buffer_cast<const uint8_t*>(buffer);
+    if (data >= large->data() && data < large->data() + large->size())
+      ++nReferences;
+  }
+  return nReferences;
+}
+
+BOOST_AUTO_TEST_CASE(Wired)
+{
+  ConstBufferPtr payload = makePayload(3000);
+  Block content(tlv::Content, payload);
+  content.encode();
+  BOOST_CHECK_EQUAL(checkGathered(content, content.getBuffer()), 1);
+
+  Block small = makeNonNegativeIntegerBlock(tlv::FreshnessPeriod, 1000);
+  BOOST_CHECK_EQUAL(checkGathered(small, small.getBuffer()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ValueOnly)
+{
+  ConstBufferPtr payload = makePayload(3000);
+  Block content(tlv::Content, payload);
+  BOOST_REQUIRE(!content.hasWire());
+  BOOST_CHECK_EQUAL(checkGathered(content, payload), 1);
+
+  ConstBufferPtr smallPayload = makePayload(10);
+  BOOST_CHECK_EQUAL(checkGathered(Block(tlv::Content, smallPayload), smallPayload), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Nested)
+{
+  ConstBufferPtr payload = makePayload(5000);
+
+  Block name(tlv::Name);
+  name.push_back(makeStringBlock(tlv::NameComponent, "producer"));
+  name.push_back(makeStringBlock(tlv::NameComponent, "content"));
+  Block metaInfo(tlv::MetaInfo);
+  metaInfo.push_back(makeNonNegativeIntegerBlock(tlv::FreshnessPeriod, 4000));
+
+  Block data(tlv::Data);
+  data.push_back(name);
+  data.push_back(metaInfo);
+  data.push_back(Block(tlv::Content, payload));
+  data.push_back(makeBinaryBlock(tlv::SignatureValue, payload->data(), 32));
+  BOOST_CHECK_EQUAL(checkGathered(data, payload), 1);
+
+  // the payload is referenced however deeply it is nested
+  Block outer(100);
+  outer.push_back(data);
+  outer.push_back(Block(tlv::Content, payload));
+  BOOST_CHECK_EQUAL(checkGathered(outer, payload), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Clear)
+{
+  GatherEncoder encoder(16);
+  encoder.appendBlock(makeNonNegativeIntegerBlock(tlv::FreshnessPeriod, 1000));
+  encoder.clear();
+  BOOST_CHECK_EQUAL(encoder.size(), 0);
+  BOOST_CHECK(encoder.buffers().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestGatherEncoder
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace encoding
+} // namespace ndn
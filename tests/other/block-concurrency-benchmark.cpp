@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+/** @file
+ *  Measures how reading the same shared Blocks scales with the number of worker threads.
+ *
+ *  Each worker repeatedly looks up subelements of every Block in a shared set, as
+ *  a forwarding pipeline does with cached Data, so all but the first parse of each Block
+ *  take the lock-free path.  Usage: block-concurrency-benchmark [max-threads]
+ */
+
+#include "../../block.hpp"
+#include "../../block-helpers.hpp"
+#include "../../encoding-buffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+static const size_t N_BLOCKS = 1024;
+static const size_t N_ELEMENTS = 12;
+static const size_t N_READS_PER_THREAD = 4000000;
+
+static Block
+makeBlock(size_t seed)
+{
+  EncodingBuffer encoder;
+  for (size_t i = 0; i < N_ELEMENTS; ++i) {
+    prependNonNegativeIntegerBlock(encoder, i + 1, seed + i);
+  }
+  encoder.prependVarNumber(encoder.size());
+  encoder.prependVarNumber(100);
+  return Block(encoder);
+}
+
+static uint64_t
+readBlocks(const std::vector<Block>& blocks, size_t offset)
+{
+  uint64_t sum = 0;
+  for (size_t i = 0; i < N_READS_PER_THREAD; ++i) {
+    const Block& block = blocks[(offset + i) % blocks.size()];
+    block.parse();
+    sum += readNonNegativeInteger(*block.find(i % N_ELEMENTS + 1));
+  }
+  return sum;
+}
+
+static void
+run(size_t nThreads)
+{
+  // fresh copies, so that the first reads race on parsing
+  std::vector<Block> blocks;
+  for (size_t i = 0; i < N_BLOCKS; ++i) {
+    Block block = makeBlock(i);
+    blocks.push_back(Block(block.wire(), block.size()));
+  }
+
+  std::atomic<uint64_t> total(0);
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < nThreads; ++i) {
+    threads.emplace_back([&blocks, &total, i] { total += readBlocks(blocks, i * 97); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  double nReads = static_cast<double>(nThreads * N_READS_PER_THREAD);
+  std::cout << nThreads << " threads: " << nReads / elapsed.count() / 1e6 << " M reads/s, "
+            << nReads / elapsed.count() / 1e6 / nThreads << " M reads/s per thread"
+            << " (checksum " << total << ")" << std::endl;
+}
+
+} // namespace tests
+} // namespace ndn
+
+int
+main(int argc, char** argv)
+{
+  size_t maxThreads = std::thread::hardware_concurrency();
+  if (argc > 1)
+    maxThreads = std::strtoul(argv[1], nullptr, 10);
+  if (maxThreads == 0)
+    maxThreads = 1;
+
+  for (size_t nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+    ndn::tests::run(nThreads);
+  }
+  return 0;
+}
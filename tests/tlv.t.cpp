@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../tlv.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tlv {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestTlv)
+
+BOOST_AUTO_TEST_CASE(ReadNonNegativeIntegerNoThrow)
+{
+  static const uint8_t BUFFER[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+  const uint8_t* begin = BUFFER;
+  uint64_t number = 0;
+  BOOST_CHECK(readNonNegativeInteger(1, begin, BUFFER + sizeof(BUFFER), number));
+  BOOST_CHECK_EQUAL(number, 0x01);
+  BOOST_CHECK(begin == BUFFER + 1);
+
+  begin = BUFFER;
+  BOOST_CHECK(readNonNegativeInteger(2, begin, BUFFER + sizeof(BUFFER), number));
+  BOOST_CHECK_EQUAL(number, 0x0102);
+
+  begin = BUFFER;
+  BOOST_CHECK(readNonNegativeInteger(4, begin, BUFFER + sizeof(BUFFER), number));
+  BOOST_CHECK_EQUAL(number, 0x01020304);
+
+  begin = BUFFER;
+  BOOST_CHECK(readNonNegativeInteger(8, begin, BUFFER + sizeof(BUFFER), number));
+  BOOST_CHECK_EQUAL(number, 0x0102030405060708);
+  BOOST_CHECK(begin == BUFFER + 8);
+
+  // invalid size
+  for (size_t size : {0, 3, 5, 7, 9}) {
+    begin = BUFFER;
+    BOOST_CHECK(!readNonNegativeInteger(size, begin, BUFFER + sizeof(BUFFER), number));
+  }
+
+  // not enough data
+  for (size_t size : {1, 2, 4, 8}) {
+    begin = BUFFER;
+    BOOST_CHECK(!readNonNegativeInteger(size, begin, BUFFER + size - 1, number));
+    begin = BUFFER;
+    BOOST_CHECK_THROW(readNonNegativeInteger(size, begin, BUFFER + size - 1), Error);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ReadVarNumberNoThrow)
+{
+  static const uint8_t BUFFER[] = {0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00};
+
+  const uint8_t* begin = BUFFER;
+  uint64_t number = 0;
+  BOOST_CHECK(readVarNumber(begin, BUFFER + sizeof(BUFFER), number));
+  BOOST_CHECK_EQUAL(number, 0x100000000);
+
+  // empty input
+  begin = BUFFER;
+  BOOST_CHECK(!readVarNumber(begin, begin, number));
+
+  // truncated 2-, 4-, and 8-octet numbers
+  static const uint8_t TRUNCATED_2[] = {0xfd, 0x01};
+  begin = TRUNCATED_2;
+  BOOST_CHECK(!readVarNumber(begin, TRUNCATED_2 + sizeof(TRUNCATED_2), number));
+
+  static const uint8_t TRUNCATED_4[] = {0xfe, 0x01, 0x02, 0x03};
+  begin = TRUNCATED_4;
+  BOOST_CHECK(!readVarNumber(begin, TRUNCATED_4 + sizeof(TRUNCATED_4), number));
+
+  begin = BUFFER;
+  BOOST_CHECK(!readVarNumber(begin, BUFFER + sizeof(BUFFER) - 1, number));
+}
+
+BOOST_AUTO_TEST_CASE(ReadTypeNoThrow)
+{
+  static const uint8_t BUFFER[] = {0xfe, 0xff, 0xff, 0xff, 0xff};
+
+  const uint8_t* begin = BUFFER;
+  uint32_t type = 0;
+  BOOST_CHECK(readType(begin, BUFFER + sizeof(BUFFER), type));
+  BOOST_CHECK_EQUAL(type, 0xffffffff);
+
+  // TLV-TYPE does not fit in 32 bits
+  static const uint8_t TOO_LARGE[] = {0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00};
+  begin = TOO_LARGE;
+  BOOST_CHECK(!readType(begin, TOO_LARGE + sizeof(TOO_LARGE), type));
+
+  begin = BUFFER;
+  BOOST_CHECK(!readType(begin, BUFFER + 2, type));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTlv
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace tlv
+} // namespace ndn
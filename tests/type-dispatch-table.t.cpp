@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "../type-dispatch-table.hpp"
+#include "../block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tlv {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Encoding)
+BOOST_AUTO_TEST_SUITE(TestTypeDispatchTable)
+
+BOOST_AUTO_TEST_CASE(Lookup)
+{
+  TypeDispatchTable table{0x07, 0x0a, 0x80, 1023, 1024, 0xfffffffe};
+  BOOST_CHECK_EQUAL(table.size(), 6);
+
+  BOOST_CHECK_EQUAL(table(0x07), 1);
+  BOOST_CHECK_EQUAL(table(0x0a), 2);
+  BOOST_CHECK_EQUAL(table(0x80), 3);
+  BOOST_CHECK_EQUAL(table(1023), 4);
+  BOOST_CHECK_EQUAL(table(1024), 5);
+  BOOST_CHECK_EQUAL(table(0xfffffffe), 6);
+
+  BOOST_CHECK_EQUAL(table(0), TypeDispatchTable::UNKNOWN);
+  BOOST_CHECK_EQUAL(table(0x08), TypeDispatchTable::UNKNOWN);
+  BOOST_CHECK_EQUAL(table(1022), TypeDispatchTable::UNKNOWN);
+  BOOST_CHECK_EQUAL(table(1025), TypeDispatchTable::UNKNOWN);
+  BOOST_CHECK_EQUAL(table(0xffffffff), TypeDispatchTable::UNKNOWN);
+
+  TypeDispatchTable empty{};
+  BOOST_CHECK_EQUAL(empty.size(), 0);
+  BOOST_CHECK_EQUAL(empty(0), TypeDispatchTable::UNKNOWN);
+  BOOST_CHECK_EQUAL(empty(2000), TypeDispatchTable::UNKNOWN);
+
+  BOOST_CHECK_THROW((TypeDispatchTable{0x07, 0x0a, 0x07}), std::invalid_argument);
+  BOOST_CHECK_THROW((TypeDispatchTable{2000, 2000}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(CriticalType)
+{
+  BOOST_CHECK(isCriticalType(0));
+  BOOST_CHECK(isCriticalType(30));
+  BOOST_CHECK(isCriticalType(31));
+  BOOST_CHECK(!isCriticalType(32));
+  BOOST_CHECK(isCriticalType(33));
+  BOOST_CHECK(!isCriticalType(0x80));
+  BOOST_CHECK(isCriticalType(0xfd01));
+}
+
+BOOST_AUTO_TEST_CASE(Dispatch)
+{
+  static const TypeDispatchTable table{0x80, 0x82};
+
+  Block block(0x64);
+  block.push_back(makeNonNegativeIntegerBlock(0x82, 2));
+  block.push_back(makeNonNegativeIntegerBlock(0xfc, 0)); // unknown non-critical
+  block.push_back(makeNonNegativeIntegerBlock(0x80, 1));
+  block.encode();
+
+  std::vector<std::pair<size_t, uint64_t>> calls;
+  auto handler = [&calls] (size_t index, const Block& element) {
+    calls.push_back(std::make_pair(index, readNonNegativeInteger(element)));
+  };
+
+  block.parse();
+  dispatchElements(block, table, handler);
+  BOOST_REQUIRE_EQUAL(calls.size(), 2);
+  BOOST_CHECK_EQUAL(calls[0].first, 2);
+  BOOST_CHECK_EQUAL(calls[0].second, 2);
+  BOOST_CHECK_EQUAL(calls[1].first, 1);
+  BOOST_CHECK_EQUAL(calls[1].second, 1);
+
+  // unknown critical type
+  block.push_back(makeNonNegativeIntegerBlock(0x81, 3));
+  calls.clear();
+  BOOST_CHECK_THROW(dispatchElements(block, table, handler), Error);
+  BOOST_CHECK_EQUAL(calls.size(), 2);
+
+  Block lowType(0x64);
+  lowType.push_back(makeNonNegativeIntegerBlock(0x10, 0));
+  BOOST_CHECK_THROW(dispatchElements(lowType, table, handler), Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestTypeDispatchTable
+BOOST_AUTO_TEST_SUITE_END() // Encoding
+
+} // namespace tests
+} // namespace tlv
+} // namespace ndn
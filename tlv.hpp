@@ -22,10 +22,12 @@
 #ifndef NDN_ENCODING_TLV_HPP
 #define NDN_ENCODING_TLV_HPP
 
+#include <cstring>
 #include <stdexcept>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <type_traits>
 
 #include "buffer.hpp"
 #include "endian.hpp"
@@ -145,6 +147,9 @@ enum ContentTypeValue {
  * @throws This call never throws exception
  *
  * @return true if number successfully read from input, false otherwise
+ *
+ * When @p begin and @p end are pointers or Buffer iterators, the multi-octet forms are read
+ * from contiguous memory with a single bounds check.
  */
 template<class InputIterator>
 inline bool
@@ -193,7 +198,7 @@ readType(InputIterator& begin, const InputIterator& end);
 /**
  * @brief Get number of bytes necessary to hold value of VAR-NUMBER
  */
-inline size_t
+constexpr size_t
 sizeOfVarNumber(uint64_t varNumber);
 
 /**
@@ -202,6 +207,37 @@ sizeOfVarNumber(uint64_t varNumber);
 inline size_t
 writeVarNumber(std::ostream& os, uint64_t varNumber);
 
+/**
+ * @brief Write VAR-NUMBER to the specified memory
+ *
+ * @param [out] buffer    Output memory; at least sizeOfVarNumber(varNumber) octets must be writable
+ * @param [in]  varNumber Number to write
+ *
+ * @return number of octets written
+ */
+inline size_t
+writeVarNumber(uint8_t* buffer, uint64_t varNumber);
+
+/**
+ * @brief Encoding of TLV-TYPE @p TYPE, determined at compile time
+ *
+ * Use this when the type code is a compile-time constant, such as tlv::Name.  SIZE is a
+ * constant expression, and write() reduces to constant stores.
+ */
+template<uint32_t TYPE>
+struct TypeHeader
+{
+  /** @brief number of octets in the encoding of TYPE
+   */
+  static constexpr size_t SIZE = sizeOfVarNumber(TYPE);
+
+  /** @brief Write the encoding of TYPE to @p buffer, which must have SIZE writable octets
+   *  @return SIZE
+   */
+  static size_t
+  write(uint8_t* buffer);
+};
+
 /**
  * @brief Read nonNegativeInteger in NDN-TLV encoding
  *
@@ -216,10 +252,28 @@ template<class InputIterator>
 inline uint64_t
 readNonNegativeInteger(size_t size, InputIterator& begin, const InputIterator& end);
 
+/**
+ * @brief Read nonNegativeInteger in NDN-TLV encoding
+ *
+ * @param [in]  size   Number of octets of the nonNegativeInteger (1, 2, 4, or 8)
+ * @param [in]  begin  Begin (pointer or iterator) of the buffer
+ * @param [in]  end    End (pointer or iterator) of the buffer
+ * @param [out] number Read number
+ *
+ * @throws This call never throws exception
+ *
+ * @return true if number successfully read from input, false if @p size is invalid or
+ *         there is not enough data
+ */
+template<class InputIterator>
+inline bool
+readNonNegativeInteger(size_t size, InputIterator& begin, const InputIterator& end,
+                       uint64_t& number);
+
 /**
  * @brief Get number of bytes necessary to hold value of nonNegativeInteger
  */
-inline size_t
+constexpr size_t
 sizeOfNonNegativeInteger(uint64_t varNumber);
 
 /**
@@ -228,6 +282,64 @@ sizeOfNonNegativeInteger(uint64_t varNumber);
 inline size_t
 writeNonNegativeInteger(std::ostream& os, uint64_t varNumber);
 
+/**
+ * @brief Write nonNegativeInteger to the specified memory
+ *
+ * @param [out] buffer    Output memory; at least sizeOfNonNegativeInteger(varNumber) octets
+ *                        must be writable
+ * @param [in]  varNumber Number to write
+ *
+ * @return number of octets written
+ */
+inline size_t
+writeNonNegativeInteger(uint8_t* buffer, uint64_t varNumber);
+
+/**
+ * @brief Type, length, and position of a TLV element found by scanElements
+ *
+ * Offsets are relative to the beginning of the scanned range.
+ */
+struct ElementHeader
+{
+  uint32_t type;
+  uint32_t length;
+  uint32_t offset;      ///< offset of TLV-TYPE
+  uint32_t valueOffset; ///< offset of TLV-VALUE
+};
+
+/**
+ * @brief Scan the headers of all top-level TLV elements in [@p begin, @p end)
+ *
+ * @param [in]  begin    Begin (pointer or iterator) of the buffer
+ * @param [in]  end      End (pointer or iterator) of the buffer
+ * @param [out] headers  Container to which an ElementHeader is appended for every element
+ *
+ * @throws This call never throws exception (except from @p headers allocation)
+ *
+ * @p Iterator must be a RandomAccessIterator.  The range is walked once; TLV-VALUE of each
+ * element is skipped without being inspected.
+ * Headers of elements preceding a malformed element are kept in @p headers.
+ *
+ * @return true if the range consists of complete TLV elements only, false otherwise
+ */
+template<class Iterator, class Container>
+inline bool
+scanElements(Iterator begin, const Iterator& end, Container& headers);
+
+/**
+ * @brief Scan the headers of all top-level TLV elements in [@p begin, @p end), reading past
+ *        @p end
+ *
+ * This is equivalent to scanElements, but it loads 8 octets at a time to decode TLV-TYPE and
+ * TLV-LENGTH of each element together, which removes the per-field bounds checks.
+ *
+ * @pre at least 8 octets past @p end are readable, e.g., Buffer::isReadable(@p end, 8) is true
+ *      for the Buffer containing the range
+ */
+template<class Container>
+inline bool
+scanElementsPadded(const uint8_t* begin, const uint8_t* end, Container& headers);
+
 /////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////
@@ -238,6 +350,119 @@ writeNonNegativeInteger(std::ostream& os, uint64_t varNumber);
 /////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/** @brief Function object to read a big-endian number of @p size octets from a generic
+ *         InputIterator, one octet at a time
+ */
+template<class InputIterator>
+class ReadNumberSlow
+{
+public:
+  bool
+  operator()(size_t size, InputIterator& begin, const InputIterator& end, uint64_t& number) const
+  {
+    number = 0;
+    size_t count = 0;
+    for (; begin != end && count < size; ++count)
+      {
+        number = (number << 8) | static_cast<uint8_t>(*begin);
+        ++begin;
+      }
+
+    return count == size;
+  }
+};
+
+/** @brief Function object to read a big-endian number of @p size octets from contiguous memory
+ *
+ *  The remaining length is checked once, and the number is loaded with memcpy, which is
+ *  safe for unaligned input and does not violate strict aliasing.
+ */
+template<class Iterator>
+class ReadNumberFast
+{
+public:
+  bool
+  operator()(size_t size, Iterator& begin, const Iterator& end, uint64_t& number) const
+  {
+    if (static_cast<size_t>(end - begin) < size)
+      return false;
+
+    const uint8_t* first = reinterpret_cast<const uint8_t*>(&*begin);
+    switch (size) {
+    case 1:
+      {
+        number = *first;
+        break;
+      }
+    case 2:
+      {
+        uint16_t value = 0;
+        std::memcpy(&value, first, 2);
+        number = be16toh(value);
+        break;
+      }
+    case 4:
+      {
+        uint32_t value = 0;
+        std::memcpy(&value, first, 4);
+        number = be32toh(value);
+        break;
+      }
+    default: // case 8:
+      {
+        uint64_t value = 0;
+        std::memcpy(&value, first, 8);
+        number = be64toh(value);
+        break;
+      }
+    }
+
+    begin += size;
+    return true;
+  }
+};
+
+/** @brief Determine whether @p Iterator refers to contiguous memory of octets
+ *
+ *  True for pointers to 1-octet types and for iterators of Buffer (std::vector<uint8_t>).
+ */
+template<class Iterator>
+struct IsContiguousOctetIterator
+{
+  typedef typename std::iterator_traits<Iterator>::value_type ValueType;
+
+  static const bool value =
+    sizeof(ValueType) == 1 &&
+    (std::is_pointer<Iterator>::value ||
+     std::is_same<Iterator, Buffer::const_iterator>::value ||
+     std::is_same<Iterator, Buffer::iterator>::value);
+};
+
+/** @brief Function object to read a big-endian number, selecting the contiguous-memory
+ *         implementation when @p Iterator allows it
+ */
+template<class Iterator>
+class ReadNumber : public std::conditional<IsContiguousOctetIterator<Iterator>::value,
+                                           ReadNumberFast<Iterator>,
+                                           ReadNumberSlow<Iterator>>::type
+{
+};
+
+/** @brief Read a big-endian number of @p size octets (1 to 8) with one 8-octet load
+ *  @pre 8 octets starting at @p first are readable
+ */
+inline uint64_t
+readNumberPadded(const uint8_t* first, size_t size)
+{
+  uint64_t value = 0;
+  std::memcpy(&value, first, 8);
+  return be64toh(value) >> (64 - 8 * size);
+}
+
+} // namespace detail
+
 template<class InputIterator>
 inline bool
 readVarNumber(InputIterator& begin, const InputIterator& end, uint64_t& number)
@@ -250,37 +475,12 @@ readVarNumber(InputIterator& begin, const InputIterator& end, uint64_t& number)
   if (firstOctet < 253)
     {
       number = firstOctet;
-    }
-  else if (firstOctet == 253)
-    {
-      if (end - begin < 2)
-        return false;
-
-      uint16_t value = *reinterpret_cast<const uint16_t*>(&*begin);
-      begin += 2;
-      number = be16toh(value);
-    }
-  else if (firstOctet == 254)
-    {
-      if (end - begin < 4)
-        return false;
-
-      uint32_t value = *reinterpret_cast<const uint32_t*>(&*begin);
-      begin += 4;
-      number = be32toh(value);
-    }
-  else // if (firstOctet == 255)
-    {
-      if (end - begin < 8)
-        return false;
-
-      uint64_t value = *reinterpret_cast<const uint64_t*>(&*begin);
-      begin += 8;
-
-      number = be64toh(value);
+      return true;
     }
 
-  return true;
+  // 253 => 2 octets, 254 => 4 octets, 255 => 8 octets
+  size_t size = size_t(1) << (firstOctet - 252);
+  return detail::ReadNumber<InputIterator>()(size, begin, end, number);
 }
 
 template<class InputIterator>
@@ -313,64 +513,6 @@ readVarNumber(InputIterator& begin, const InputIterator& end)
   return value;
 }
 
-template<>
-inline bool
-readVarNumber<std::istream_iterator<uint8_t>>(std::istream_iterator<uint8_t>& begin,
-                                              const std::istream_iterator<uint8_t>& end,
-                                              uint64_t& value)
-{
-  if (begin == end)
-    return false;
-
-  uint8_t firstOctet = *begin;
-  ++begin;
-  if (firstOctet < 253)
-    {
-      value = firstOctet;
-    }
-  else if (firstOctet == 253)
-    {
-      value = 0;
-      size_t count = 0;
-      for (; begin != end && count < 2; ++count)
-        {
-          value = ((value << 8) | *begin); //λ
-          begin++;
-        }
-
-      if (count != 2)
-        return false;
-    }
-  else if (firstOctet == 254)
-    {
-      value = 0;
-      size_t count = 0;
-      for (; begin != end && count < 4; ++count)
-        {
-          value = ((value << 8) | *begin);
-          begin++;
-        }
-
-      if (count != 4)
-        return false;
-    }
-  else // if (firstOctet == 255)
-    {
-      value = 0;
-      size_t count = 0;
-      for (; begin != end && count < 8; ++count)
-        {
-          value = ((value << 8) | *begin);
-          begin++;
-        }
-
-      if (count != 8)
-        return false;
-    }
-
-  return true;
-}
-
 template<class InputIterator>
 inline uint32_t
 readType(InputIterator& begin, const InputIterator& end)
@@ -384,202 +526,202 @@ readType(InputIterator& begin, const InputIterator& end)
   return static_cast<uint32_t>(type);
 }
 
-size_t
+constexpr size_t
 sizeOfVarNumber(uint64_t varNumber)
 {
-  if (varNumber < 253) {
-    return 1;
-  }
-  else if (varNumber <= std::numeric_limits<uint16_t>::max()) {
-    return 3;
-  }
-  else if (varNumber <= std::numeric_limits<uint32_t>::max()) {
-    return 5;
-  }
-  else {
-    return 9;
-  }
+  return varNumber < 253 ? 1 :
+         varNumber <= std::numeric_limits<uint16_t>::max() ? 3 :
+         varNumber <= std::numeric_limits<uint32_t>::max() ? 5 : 9;
 }
 
 inline size_t
-writeVarNumber(std::ostream& os, uint64_t varNumber)
+writeVarNumber(uint8_t* buffer, uint64_t varNumber)
 {
   if (varNumber < 253) {
-    os.put(static_cast<char>(varNumber));  //insert varNumber
+    buffer[0] = static_cast<uint8_t>(varNumber);
     return 1;
   }
   else if (varNumber <= std::numeric_limits<uint16_t>::max()) {
-    os.put(static_cast<char>(253)); //first is 253
-    uint16_t value = htobe16(static_cast<uint16_t>(varNumber)); //***
-    os.write(reinterpret_cast<const char*>(&value), 2);
+    buffer[0] = 253;
+    uint16_t value = htobe16(static_cast<uint16_t>(varNumber));
+    std::memcpy(buffer + 1, &value, 2);
     return 3;
   }
   else if (varNumber <= std::numeric_limits<uint32_t>::max()) {
-    os.put(static_cast<char>(254));//first is 254
+    buffer[0] = 254;
     uint32_t value = htobe32(static_cast<uint32_t>(varNumber));
-    os.write(reinterpret_cast<const char*>(&value), 4);
+    std::memcpy(buffer + 1, &value, 4);
     return 5;
   }
   else {
-    os.put(static_cast<char>(255));
+    buffer[0] = 255;
     uint64_t value = htobe64(varNumber);
-    os.write(reinterpret_cast<const char*>(&value), 8);
+    std::memcpy(buffer + 1, &value, 8);
     return 9;
   }
 }
 
-template<class InputIterator>
-inline uint64_t
-readNonNegativeInteger(size_t size, InputIterator& begin, const InputIterator& end)
+inline size_t
+writeVarNumber(std::ostream& os, uint64_t varNumber)
 {
-  switch (size) {
-  case 1:
-    {
-      if (end - begin < 1)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
-
-      uint8_t value = *begin;
-      begin++;
-      return value;
-    }
-  case 2:
-    {
-      if (end - begin < 2)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
-
-      uint16_t value = *reinterpret_cast<const uint16_t*>(&*begin);
-      begin += 2;
-      return be16toh(value);
-    }
-  case 4:
-    {
-      if (end - begin < 4)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
+  uint8_t buffer[9];
+  size_t length = writeVarNumber(buffer, varNumber);
+  os.write(reinterpret_cast<const char*>(buffer), length);
+  return length;
+}
 
-      uint32_t value = *reinterpret_cast<const uint32_t*>(&*begin);
-      begin += 4;
-      return be32toh(value);
-    }
-  case 8:
-    {
-      if (end - begin < 8)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
+template<uint32_t TYPE>
+constexpr size_t TypeHeader<TYPE>::SIZE;
 
-      uint64_t value = *reinterpret_cast<const uint64_t*>(&*begin);
-      begin += 8;
-      return be64toh(value);
-    }
-  }
-  BOOST_THROW_EXCEPTION(Error("Invalid length for nonNegativeInteger (only 1, 2, 4, and 8 are allowed)"));
+template<uint32_t TYPE>
+inline size_t
+TypeHeader<TYPE>::write(uint8_t* buffer)
+{
+  // TYPE is a constant, so all branches of writeVarNumber are resolved at compile time
+  return writeVarNumber(buffer, TYPE);
 }
 
-template<>
+template<class InputIterator>
 inline uint64_t
-readNonNegativeInteger<std::istream_iterator<uint8_t> >(size_t size,
-                                                        std::istream_iterator<uint8_t>& begin,
-                                                        const std::istream_iterator<uint8_t>& end)
+readNonNegativeInteger(size_t size, InputIterator& begin, const InputIterator& end)
 {
-  switch (size) {
-  case 1:
-    {
-      if (begin == end)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
+  if (size != 1 && size != 2 && size != 4 && size != 8)
+    BOOST_THROW_EXCEPTION(Error("Invalid length for nonNegativeInteger (only 1, 2, 4, and 8 are allowed)"));
 
-      uint64_t value = *begin;
-      begin++;
-      return value;
-    }
-  case 2:
-    {
-      uint64_t value = 0;
-      size_t count = 0;
-      for (; begin != end && count < 2; ++count)
-        {
-          value = ((value << 8) | *begin);
-          begin++;
-        }
-
-      if (count != 2)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
-
-      return value;
-    }
-  case 4:
-    {
-      uint64_t value = 0;
-      size_t count = 0;
-      for (; begin != end && count < 4; ++count)
-        {
-          value = ((value << 8) | *begin);
-          begin++;
-        }
-
-      if (count != 4)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
+  uint64_t number = 0;
+  bool isOk = detail::ReadNumber<InputIterator>()(size, begin, end, number);
+  if (!isOk)
+    BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
 
-      return value;
-    }
-  case 8:
-    {
-      uint64_t value = 0;
-      size_t count = 0;
-      for (; begin != end && count < 8; ++count)
-        {
-          value = ((value << 8) | *begin);
-          begin++;
-        }
+  return number;
+}
 
-      if (count != 8)
-        BOOST_THROW_EXCEPTION(Error("Insufficient data during TLV processing"));
+template<class InputIterator>
+inline bool
+readNonNegativeInteger(size_t size, InputIterator& begin, const InputIterator& end,
+                       uint64_t& number)
+{
+  if (size != 1 && size != 2 && size != 4 && size != 8)
+    return false;
 
-      return value;
-    }
-  }
-  BOOST_THROW_EXCEPTION(Error("Invalid length for nonNegativeInteger (only 1, 2, 4, and 8 are allowed)"));
+  return detail::ReadNumber<InputIterator>()(size, begin, end, number);
 }
 
-inline size_t
+constexpr size_t
 sizeOfNonNegativeInteger(uint64_t varNumber)
 {
-  if (varNumber < 253) {
-    return 1;
-  }
-  else if (varNumber <= std::numeric_limits<uint16_t>::max()) {
-    return 2;
-  }
-  else if (varNumber <= std::numeric_limits<uint32_t>::max()) {
-    return 4;
-  }
-  else {
-    return 8;
-  }
+  return varNumber <= std::numeric_limits<uint8_t>::max() ? 1 :
+         varNumber <= std::numeric_limits<uint16_t>::max() ? 2 :
+         varNumber <= std::numeric_limits<uint32_t>::max() ? 4 : 8;
 }
 
-
 inline size_t
-writeNonNegativeInteger(std::ostream& os, uint64_t varNumber)
+writeNonNegativeInteger(uint8_t* buffer, uint64_t varNumber)
 {
-  if (varNumber < 253) {
-    os.put(static_cast<char>(varNumber));
+  if (varNumber <= std::numeric_limits<uint8_t>::max()) {
+    buffer[0] = static_cast<uint8_t>(varNumber);
     return 1;
   }
   else if (varNumber <= std::numeric_limits<uint16_t>::max()) {
     uint16_t value = htobe16(static_cast<uint16_t>(varNumber));
-    os.write(reinterpret_cast<const char*>(&value), 2);
+    std::memcpy(buffer, &value, 2);
     return 2;
   }
   else if (varNumber <= std::numeric_limits<uint32_t>::max()) {
     uint32_t value = htobe32(static_cast<uint32_t>(varNumber));
-    os.write(reinterpret_cast<const char*>(&value), 4);
+    std::memcpy(buffer, &value, 4);
     return 4;
   }
   else {
     uint64_t value = htobe64(varNumber);
-    os.write(reinterpret_cast<const char*>(&value), 8);
+    std::memcpy(buffer, &value, 8);
     return 8;
   }
 }
 
+inline size_t
+writeNonNegativeInteger(std::ostream& os, uint64_t varNumber)
+{
+  uint8_t buffer[8];
+  size_t length = writeNonNegativeInteger(buffer, varNumber);
+  os.write(reinterpret_cast<const char*>(buffer), length);
+  return length;
+}
+
+template<class Iterator, class Container>
+inline bool
+scanElements(Iterator begin, const Iterator& end, Container& headers)
+{
+  const Iterator first = begin;
+  if (static_cast<uint64_t>(end - first) > std::numeric_limits<uint32_t>::max())
+    return false;
+
+  while (begin != end)
+    {
+      ElementHeader header;
+      header.offset = static_cast<uint32_t>(begin - first);
+
+      uint64_t length = 0;
+      if (!readType(begin, end, header.type) ||
+          !readVarNumber(begin, end, length) ||
+          length > static_cast<uint64_t>(end - begin))
+        {
+          return false;
+        }
+
+      header.length = static_cast<uint32_t>(length);
+      header.valueOffset = static_cast<uint32_t>(begin - first);
+      headers.push_back(header);
+
+      begin += length;
+    }
+
+  return true;
+}
+
+template<class Container>
+inline bool
+scanElementsPadded(const uint8_t* begin, const uint8_t* end, Container& headers)
+{
+  const uint8_t* first = begin;
+  if (static_cast<uint64_t>(end - first) > std::numeric_limits<uint32_t>::max())
+    return false;
+
+  while (begin != end)
+    {
+      ElementHeader header;
+      header.offset = static_cast<uint32_t>(begin - first);
+
+      // TLV-TYPE and TLV-LENGTH below 253 (the common case) are the two leading octets
+      uint64_t octets = detail::readNumberPadded(begin, 8);
+      uint8_t typeOctet = static_cast<uint8_t>(octets >> 56);
+      uint8_t lengthOctet = static_cast<uint8_t>(octets >> 48);
+
+      uint64_t length = 0;
+      if (typeOctet < 253 && lengthOctet < 253 && end - begin >= 2)
+        {
+          header.type = typeOctet;
+          length = lengthOctet;
+          begin += 2;
+        }
+      else if (!readType(begin, end, header.type) ||
+               !readVarNumber(begin, end, length))
+        {
+          return false;
+        }
+
+      if (length > static_cast<uint64_t>(end - begin))
+        return false;
+
+      header.length = static_cast<uint32_t>(length);
+      header.valueOffset = static_cast<uint32_t>(begin - first);
+      headers.push_back(header);
+
+      begin += length;
+    }
+
+  return true;
+}
 
 } // namespace tlv
 } // namespace ndn
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "type-dispatch-table.hpp"
+
+namespace ndn {
+namespace tlv {
+
+const size_t TypeDispatchTable::UNKNOWN;
+const uint32_t TypeDispatchTable::MAX_DIRECT_TYPE;
+
+TypeDispatchTable::TypeDispatchTable(std::initializer_list<uint32_t> types)
+  : m_nTypes(types.size())
+{
+  if (m_nTypes >= std::numeric_limits<uint8_t>::max())
+    BOOST_THROW_EXCEPTION(std::invalid_argument("Too many TLV-TYPEs in dispatch table"));
+
+  // the flat table covers all recognized types up to MAX_DIRECT_TYPE, and nothing more
+  uint32_t maxDirectType = 0;
+  for (uint32_t type : types) {
+    if (type <= MAX_DIRECT_TYPE && type > maxDirectType)
+      maxDirectType = type;
+  }
+  m_direct.resize(m_nTypes == 0 ? 0 : maxDirectType + 1, UNKNOWN);
+
+  uint8_t index = 0;
+  for (uint32_t type : types) {
+    ++index;
+    if (operator()(type) != UNKNOWN)
+      BOOST_THROW_EXCEPTION(std::invalid_argument("Duplicate TLV-TYPE " + std::to_string(type) +
+                                                  " in dispatch table"));
+
+    if (type <= MAX_DIRECT_TYPE) {
+      m_direct[type] = index;
+    }
+    else {
+      auto it = std::lower_bound(m_sparse.begin(), m_sparse.end(), std::make_pair(type, uint8_t(0)));
+      m_sparse.insert(it, std::make_pair(type, index));
+    }
+  }
+}
+
+size_t
+TypeDispatchTable::findSparse(uint32_t type) const
+{
+  auto it = std::lower_bound(m_sparse.begin(), m_sparse.end(), std::make_pair(type, uint8_t(0)));
+  if (it != m_sparse.end() && it->first == type)
+    return it->second;
+
+  return UNKNOWN;
+}
+
+} // namespace tlv
+} // namespace ndn
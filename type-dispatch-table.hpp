@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_TYPE_DISPATCH_TABLE_HPP
+#define NDN_ENCODING_TYPE_DISPATCH_TABLE_HPP
+
+#include "../common.hpp"
+#include "block.hpp"
+
+#include <initializer_list>
+
+namespace ndn {
+namespace tlv {
+
+/** @brief Determine whether TLV-TYPE @p type is critical
+ *
+ *  An element of unrecognized critical type is a decoding error, while an element of
+ *  unrecognized non-critical type can be ignored.  Types 0 to 31 and odd types are critical.
+ */
+constexpr bool
+isCriticalType(uint32_t type)
+{
+  return type <= 31 || (type & 0x01) == 1;
+}
+
+/** @brief Maps the TLV-TYPE codes recognized in one decoding context to dense handler indices
+ *
+ *  TLV-TYPE numbers overlap between contexts: e.g., 128 is NfdVersion in ForwarderStatus,
+ *  FaceStatus in a face dataset, and FibEntry in a FIB dataset.  A decoder therefore builds
+ *  one table per context, usually as a function-local static, and switches on the index
+ *  instead of the type code.
+ *
+ *  Types up to MAX_DIRECT_TYPE are resolved with a single load from a flat table; larger
+ *  types are resolved with a binary search over the (usually empty) list of such types.
+ */
+class TypeDispatchTable
+{
+public:
+  /** @brief index of any type not recognized in the context
+   */
+  static const size_t UNKNOWN = 0;
+
+  /** @brief largest TLV-TYPE stored in the flat table
+   */
+  static const uint32_t MAX_DIRECT_TYPE = 1023;
+
+  /** @brief Create a table for the recognized @p types
+   *
+   *  The i-th type of @p types (counting from zero) is mapped to index i + 1.
+   *
+   *  @throw std::invalid_argument a type is listed twice, or more than 254 types are listed
+   */
+  TypeDispatchTable(std::initializer_list<uint32_t> types);
+
+  /** @return handler index of @p type, or UNKNOWN
+   */
+  size_t
+  operator()(uint32_t type) const
+  {
+    if (type < m_direct.size())
+      return m_direct[type];
+
+    return findSparse(type);
+  }
+
+  /** @return number of recognized types
+   */
+  size_t
+  size() const
+  {
+    return m_nTypes;
+  }
+
+private:
+  size_t
+  findSparse(uint32_t type) const;
+
+private:
+  std::vector<uint8_t> m_direct;
+  std::vector<std::pair<uint32_t, uint8_t>> m_sparse; // sorted by type
+  size_t m_nTypes;
+};
+
+/** @brief Dispatch every sub element of @p block to @p handler
+ *
+ *  @param block   parsed Block whose sub elements are dispatched
+ *  @param table   dispatch table for the context of @p block
+ *  @param handler callable as handler(size_t index, const Block& element) for every element
+ *                 whose type is recognized by @p table
+ *
+ *  Elements of unrecognized non-critical type are skipped without calling @p handler.
+ *
+ *  @throw tlv::Error an element of unrecognized critical type is found
+ */
+template<class Handler>
+inline void
+dispatchElements(const Block& block, const TypeDispatchTable& table, Handler&& handler)
+{
+  for (const Block& element : block.elements()) {
+    size_t index = table(element.type());
+    if (index != TypeDispatchTable::UNKNOWN) {
+      handler(index, element);
+    }
+    else if (isCriticalType(element.type())) {
+      BOOST_THROW_EXCEPTION(Error("Unrecognized critical TLV-TYPE " +
+                                  std::to_string(element.type())));
+    }
+  }
+}
+
+} // namespace tlv
+} // namespace ndn
+
+#endif // NDN_ENCODING_TYPE_DISPATCH_TABLE_HPP